@@ -74,6 +74,8 @@ typedef struct {
 	int distance;			/* distance between first point and last point (pixel) */
 	Time duration;		/* time difference between press and release (ms) */
 	XFixed angle;			/* angel difference between horizontal line and flick line (radian) */
+	unsigned long target;	/* region of the located gesture in progress */
+	int groupid;			/* finger group, -1 if unknown */
 } XGestureNotifyFlickEvent;
 
 typedef struct {
@@ -90,6 +92,8 @@ typedef struct {
 	Time duration;		/* time difference between press and release (ms) */
 	int dx;				/* x coordinate delta */
 	int dy;				/* y coordinate delta */
+	unsigned long target;	/* region of the located gesture in progress */
+	int groupid;			/* finger group, -1 if unknown */
 } XGestureNotifyPanEvent;
 
 typedef struct {
@@ -106,6 +110,11 @@ typedef struct {
 	int cy;				/* center ycoordinate */
 	XFixed zoom;			/* zoom factor (base : 1.0) */
 	XFixed angle;			/* angel difference between first line and current line (radian) */
+	Bool has_local;		/* local_x/local_y are valid (geometry tracked) */
+	int local_x;			/* center x relative to window */
+	int local_y;			/* center y relative to window */
+	unsigned long target;	/* region under local_x/y, 0 if none */
+	int groupid;			/* finger group, -1 if unknown */
 } XGestureNotifyPinchRotationEvent;
 
 typedef struct {
@@ -121,6 +130,11 @@ typedef struct {
 	int cy;				/* center ycoordinate */
 	int tap_repeat;		/* tap repeats such as SINGLE_TAP, DBL_TAP and so on */
 	Time interval;		/* time difference between tap and previous tap (ms) */
+	Bool has_local;		/* local_x/local_y are valid (geometry tracked) */
+	int local_x;			/* center x relative to window */
+	int local_y;			/* center y relative to window */
+	unsigned long target;	/* region under local_x/y, 0 if none */
+	int groupid;			/* finger group, -1 if unknown */
 } XGestureNotifyTapEvent;
 
 typedef struct {
@@ -136,6 +150,11 @@ typedef struct {
 	int cy;				/* center ycoordinate */
 	Time interval;		/* time difference between tap and hold (ms) */
 	Time holdtime;		/* hold time (ms) */
+	Bool has_local;		/* local_x/local_y are valid (geometry tracked) */
+	int local_x;			/* center x relative to window */
+	int local_y;			/* center y relative to window */
+	unsigned long target;	/* region under local_x/y, 0 if none */
+	int groupid;			/* finger group, -1 if unknown */
 } XGestureNotifyTapNHoldEvent;
 
 typedef struct {
@@ -150,6 +169,11 @@ typedef struct {
 	int cx;				/* center x coordinate */
 	int cy;				/* center ycoordinate */
 	Time holdtime;		/* hold time (ms) */
+	Bool has_local;		/* local_x/local_y are valid (geometry tracked) */
+	int local_x;			/* center x relative to window */
+	int local_y;			/* center y relative to window */
+	unsigned long target;	/* region under local_x/y, 0 if none */
+	int groupid;			/* finger group, -1 if unknown */
 } XGestureNotifyHoldEvent;
 
 union _XGestureCommonEvent {
@@ -173,22 +197,255 @@ union _XGestureCommonEvent {
 
 typedef union _XGestureCommonEvent XGestureCommonEvent;
 
+/*
+ * Compact columnar log of gesture events.
+ *
+ * Each record takes 26 bytes instead of a full XEvent.  The meaning of the
+ * generic columns depends on the event type:
+ *
+ *   type                 aux         x, y        value[0..2]
+ *   GestureNotifyGroup   -           -           groupid, num_group, -
+ *   GestureNotifyFlick   direction   -           distance, duration, angle
+ *   GestureNotifyPan     direction   dx, dy      distance, duration, -
+ *   GestureNotifyPinchRotation -     cx, cy      zoom, angle, distance
+ *   GestureNotifyTap     tap_repeat  cx, cy      interval, -, -
+ *   GestureNotifyTapNHold -          cx, cy      interval, holdtime, -
+ *   GestureNotifyHold    -           cx, cy      holdtime, -, -
+ */
+typedef struct _XGestureEventLog XGestureEventLog;
+
+typedef struct {
+	int type;			/* GestureNotifyGroup ... GestureNotifyHold */
+	int kind;			/* subevent type */
+	int num_finger;
+	int aux;
+	Window window;
+	Time time;
+	short x;
+	short y;
+	int value[3];
+} XGestureLogRecord;
+
+typedef struct {
+	int index;			/* next record to return */
+	Time time;			/* time of the last returned record */
+} XGestureLogIter;
+
+/* lifetime of a finger group, from GestureNotifyGroup events */
+typedef struct {
+	int groupid;
+	Window window;		/* window the group was reported on */
+	int num_group;
+	Time start_time;		/* time the group was first seen */
+	Time end_time;		/* time the group was removed, 0 while active */
+	Bool active;
+} XGestureGroupInfo;
+
+/* priority dispatch instrumentation */
+typedef struct {
+	unsigned long delivered;		/* events fetched from the priority queue */
+	unsigned long events_bypassed;	/* queued Xlib events they were moved ahead of */
+	unsigned long overflowed;		/* events left in the Xlib queue, ring full */
+	unsigned long long total_wait_usec;	/* time spent in the priority queue */
+	unsigned long long max_wait_usec;
+} XGesturePriorityStats;
+
+/* client side recognizer input, one raw touch sample */
+#define XGestureTouchBegin	0
+#define XGestureTouchUpdate	1
+#define XGestureTouchEnd	2
+
+typedef struct {
+	int type;			/* XGestureTouchBegin/Update/End */
+	int touchid;
+	Window window;		/* window the gesture events are reported on */
+	Time time;
+	int x;				/* root coordinates */
+	int y;
+} XGestureTouchSample;
+
+typedef struct _XGestureRecognizer XGestureRecognizer;
+
+/* aggregates over a time range of the per-window gesture history */
+typedef struct {
+	int num_events;		/* gesture events in the range */
+	Time first_time;		/* time of the first event in the range */
+	Time last_time;		/* time of the last event in the range */
+	int num_pan;
+	long sum_dx;			/* sum of pan dx */
+	long sum_dy;			/* sum of pan dy */
+	int num_pinch;
+	XFixed mean_zoom;		/* mean pinch zoom factor */
+	int num_tap;
+} XGestureHistoryStats;
+
+/* kinetic scroller, offsets are relative to the position at release */
+typedef struct _XGestureKineticScroller XGestureKineticScroller;
+
 _XFUNCPROTOBEGIN
 
 extern Bool XGestureQueryExtension (Display *dpy, int *event_base, int *error_base);
 
+/*
+ * The version is negotiated once per display and then answered locally.
+ * A failed negotiation is not cached: the next call asks the server again.
+ */
 extern Bool XGestureQueryVersion (Display *dpy, int *majorVersion,
 			    int *minorVersion, int *patchVersion);
 
+extern Bool XGesturePrefetchVersion (Display *dpy);
+
 extern Status XGestureSelectEvents(Display* dpy, Window w, Mask mask);
 
 extern Status XGestureGetSelectedEvents(Display* dpy, Window w, Mask *mask_return);
 
+/*
+ * Checked locally before anything is sent: w must not be None, eventType
+ * a GestureNotify* type and num_finger within 1..10, a fixed library limit
+ * since the server cannot be asked for its own.  Otherwise these return
+ * GestureGrabAbnormal / GestureUngrabAbnormal without a request or error.
+ */
 extern Status XGestureGrabEvent(Display* dpy, Window w, int eventType, int num_finger, Time time);
 
 extern Status XGestureUngrabEvent(Display* dpy, Window w, int eventType, int num_finger, Time time);
 
+extern Status XGestureSendEvents(Display* dpy, Bool propagate, long event_mask,
+				 XGestureCommonEvent *events, int num_events);
+
+extern XGestureEventLog *XGestureEventLogCreate(int initial_capacity);
+
+extern void XGestureEventLogDestroy(XGestureEventLog *log);
+
+extern void XGestureEventLogClear(XGestureEventLog *log);
+
+extern int XGestureEventLogCount(XGestureEventLog *log);
+
+extern Bool XGestureEventLogAppendEvent(XGestureEventLog *log, int event_base,
+					XGestureCommonEvent *event);
+
+extern void XGestureEventLogBegin(XGestureEventLog *log, XGestureLogIter *iter);
+
+extern Bool XGestureEventLogNext(XGestureEventLog *log, XGestureLogIter *iter,
+				 XGestureLogRecord *record);
+
+extern int XGestureEventLogSerialize(XGestureEventLog *log, char *buf, int size);
+
+extern XGestureEventLog *XGestureEventLogLoad(const char *buf, int size);
+
+extern Bool XGestureSetEventLog(Display* dpy, XGestureEventLog *log);
+
+extern Bool XGestureEnableHistory(Display* dpy, Window w, int capacity);
+
+extern Bool XGestureQueryHistory(Display* dpy, Window w, Time start, Time end,
+				 XGestureHistoryStats *stats);
+
+extern Bool XGestureQueryRecentHistory(Display* dpy, Window w, Time interval,
+				       XGestureHistoryStats *stats);
+
+extern XGestureKineticScroller *XGestureKineticCreate(void);
+
+extern void XGestureKineticDestroy(XGestureKineticScroller *ks);
+
+extern Bool XGestureKineticFeed(XGestureKineticScroller *ks, int event_base,
+				XGestureCommonEvent *event);
+
+/*
+ * Offset of the fling at time.  Returns True while it moves; once it has
+ * come to rest, False with the final offset, which stays until a new Pan,
+ * a new fling or XGestureKineticStop() resets it to 0.
+ */
+extern Bool XGestureKineticGetOffset(XGestureKineticScroller *ks, Time time,
+				     int *x_return, int *y_return);
+
+extern void XGestureKineticStop(XGestureKineticScroller *ks);
+
+extern int XGestureGetEventFd(Display* dpy);
+
+extern void XGestureClearEventFd(Display* dpy);
+
+extern Bool XGestureTrackWindowGeometry(Display* dpy, Window w, Bool track);
+
+/*
+ * Regions route Tap, TapNHold, Hold and PinchRotation events by their
+ * local_x/y and are clamped to the 16-bit X coordinate range.  Pan and
+ * Flick have no position and are not routed: their target is the one of
+ * the located gesture in progress on the window, 0 if none.
+ */
+extern Bool XGestureAddRegion(Display* dpy, Window w, unsigned long id,
+			      int x, int y, unsigned int width, unsigned int height);
+
+extern Bool XGestureRemoveRegion(Display* dpy, Window w, unsigned long id);
+
+extern void XGestureClearRegions(Display* dpy, Window w);
+
+/*
+ * skip SelectEvents/GrabEvent the server already honours; grabs are
+ * forgotten on UnmapNotify/DestroyNotify, so select StructureNotify
+ */
+extern Bool XGestureSetRequestCoalescing(Display* dpy, Bool enable);
+
+extern void XGestureForgetWindow(Display* dpy, Window w);
+
+extern Bool XGestureGetGroupInfo(Display* dpy, int groupid,
+				 XGestureGroupInfo *info_return);
+
+extern Bool XGestureSetPriorityDispatch(Display* dpy, Bool enable);
+
+extern int XGesturePendingPriorityEvents(Display* dpy);
+
+extern Bool XGestureNextPriorityEvent(Display* dpy, XEvent *event_return);
+
+extern Bool XGestureGetPriorityStats(Display* dpy,
+				     XGesturePriorityStats *stats_return);
+
+extern Bool XGestureStartTelemetry(Display* dpy, const char *path,
+				   unsigned int max_bytes);
+
+extern void XGestureStopTelemetry(Display* dpy);
+
+extern XGestureRecognizer *XGestureRecognizerCreate(Display* dpy, int event_base);
+
+extern void XGestureRecognizerDestroy(XGestureRecognizer *rec);
+
+extern void XGestureRecognizerReset(XGestureRecognizer *rec);
+
+extern int XGestureRecognizerFeed(XGestureRecognizer *rec,
+				  const XGestureTouchSample *sample,
+				  XGestureCommonEvent *events_return,
+				  int max_events);
+
+extern int XGestureRecognizerTimeout(XGestureRecognizer *rec, Time now,
+				     XGestureCommonEvent *events_return,
+				     int max_events);
+
+extern Bool XGestureSetFilter(Display* dpy, Window w, int eventType,
+			      double min_cutoff, double beta, double d_cutoff);
+
 _XFUNCPROTOEND
 
+#ifdef _XINPUT2_H_
+/* feed an XI 2.2 touch event, available when XInput2.h is included first */
+static inline int
+XGestureRecognizerFeedXI2(XGestureRecognizer *rec, XIDeviceEvent *xi,
+			  XGestureCommonEvent *events_return, int max_events)
+{
+	XGestureTouchSample sample;
+
+	switch (xi->evtype) {
+		case XI_TouchBegin: sample.type = XGestureTouchBegin; break;
+		case XI_TouchUpdate: sample.type = XGestureTouchUpdate; break;
+		case XI_TouchEnd: sample.type = XGestureTouchEnd; break;
+		default: return 0;
+	}
+	sample.touchid = xi->detail;
+	sample.window = xi->event;
+	sample.time = xi->time;
+	sample.x = (int)xi->root_x;
+	sample.y = (int)xi->root_y;
+
+	return XGestureRecognizerFeed(rec, &sample, events_return, max_events);
+}
+#endif
+
 #endif//_GESTURE_LIB_H_
 
@@ -59,6 +59,7 @@ rm -rf %{buildroot}
 %manifest %{name}.manifest
 %license COPYING
 %{_libdir}/libXgesture.so.*
+%{_bindir}/xgesture-telemetry
 
 %files devel
 %manifest %{name}.manifest
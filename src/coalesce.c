@@ -0,0 +1,269 @@
+/*
+ *
+ * libxgesture
+ *
+ * Contact: Sung-Jin Park <sj76.park@samsung.com>
+ *          Sangjin LEE <lsj119@samsung.com>
+ *
+ * Copyright (c) 2011 Samsung Electronics Co., Ltd All Rights Reserved 
+ *
+ * Permission to use, copy, modify, distribute, and sell this software
+ * and its documentation for any purpose is hereby granted without
+ * fee, provided that the above copyright notice appear in all copies
+ * and that both that copyright notice and this permission notice
+ * appear in supporting documentation, and that the name of Red Hat
+ * not be used in advertising or publicity pertaining to distribution
+ * of the software without specific, written prior permission.  Red
+ * Hat makes no representations about the suitability of this software
+ * for any purpose.  It is provided "as is" without express or implied
+ * warranty.
+ *
+ * THE AUTHORS DISCLAIM ALL WARRANTIES WITH REGARD TO THIS SOFTWARE,
+ * INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS, IN
+ * NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY SPECIAL, INDIRECT OR
+ * CONSEQUENTIAL DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS
+ * OF USE, DATA OR PROFITS, WHETHER IN AN ACTION OF CONTRACT,
+ * NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN
+ * CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ *
+ */
+
+/*
+ * Redundant request elimination.
+ *
+ * With coalescing enabled the library remembers, per window, the event
+ * mask it last selected and the grabs that the server confirmed.  A
+ * SelectEvents with an unchanged mask and a GrabEvent for something that
+ * is already grabbed then complete locally.
+ *
+ * SelectEvents has no reply, so a selected mask only counts once the
+ * server has processed the request (last_request_read has passed it).
+ * Errors are watched through chained error converters: an error for the
+ * request that selected a window's mask forgets that mask again, so a
+ * retry after BadWindow or an invalid mask is always sent.
+ *
+ * GrabEvent and UngrabEvent wait for their reply, so there is never an
+ * unflushed grab left for a later ungrab to cancel; the grab record is
+ * what saves the round-trips here.
+ *
+ * The record of a window is dropped with the rest of its state on
+ * DestroyNotify, and its grabs on UnmapNotify, when the client selects
+ * StructureNotify; otherwise explicitly through XGestureForgetWindow().
+ */
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+#include <X11/Xlibint.h>
+#include <X11/extensions/Xext.h>
+#include <X11/extensions/extutil.h>
+#include <X11/extensions/gesture.h>
+#include <X11/extensions/gestureproto.h>
+#include "gestureint.h"
+
+#define GRAB_BIT(num_finger) \
+    (((num_finger) >= 0 && (num_finger) < 32) ? (1U << (num_finger)) : 0)
+
+static void
+forget_window(GestureDisplayPrivPtr priv, GestureWindowPtr win)
+{
+    win->mask_known = False;
+    win->selected_mask = 0;
+    memset(win->grabbed, 0, sizeof(win->grabbed));
+    _XGesturePruneWindow(priv, win);
+}
+
+Bool
+_XGestureSelectIsRedundant(Display *dpy, GestureDisplayPrivPtr priv,
+			   Window w, Mask mask)
+{
+    GestureWindowPtr win;
+
+    if (!priv->coalesce_requests)
+	return False;
+
+    win = _XGestureFindWindow(priv, w, False);
+    return win && win->mask_known && win->selected_mask == mask &&
+	(long)(dpy->last_request_read - win->select_seq) >= 0;
+}
+
+void
+_XGestureRecordSelect(GestureDisplayPrivPtr priv, Window w, Mask mask,
+		      unsigned long seq)
+{
+    GestureWindowPtr win;
+
+    if (!priv->coalesce_requests)
+	return;
+
+    if ((win = _XGestureFindWindow(priv, w, True))) {
+	win->mask_known = True;
+	win->selected_mask = mask;
+	win->select_seq = seq;
+    }
+}
+
+/* the SelectEvents sent as request seq failed: its mask is not in effect */
+static void
+select_failed(GestureDisplayPrivPtr priv, unsigned long seq)
+{
+    GestureWindowPtr win, next;
+    int i;
+
+    for (i = 0; i < GESTURE_WINDOW_HASH_SIZE; i++) {
+	for (win = priv->windows[i]; win; win = next) {
+	    next = win->next;
+	    if (win->mask_known && win->select_seq == seq) {
+		win->mask_known = False;
+		win->selected_mask = 0;
+		_XGesturePruneWindow(priv, win);
+	    }
+	}
+    }
+}
+
+static Bool
+request_error(Display *dpy, XErrorEvent *he, xError *we)
+{
+    XExtDisplayInfo *info = _XGestureFindDisplay (dpy);
+    GestureDisplayPrivPtr priv;
+    int i;
+
+    if (!info || !(priv = GesturePriv(info)))
+	return True;
+
+    if (XextHasExtension(info) &&
+	he->request_code == info->codes->major_opcode &&
+	he->minor_code == X_GestureSelectEvents)
+	select_failed(priv, he->serial);
+
+    for (i = 0; i < priv->num_hooked_errors; i++) {
+	if (priv->hooked_error_code[i] == he->error_code)
+	    return priv->wire_to_error[i](dpy, he, we);
+    }
+
+    return True;
+}
+
+/* every error SelectEvents can raise: the core ones and the extension's */
+static void
+hook_errors(Display *dpy, XExtDisplayInfo *info, GestureDisplayPrivPtr priv)
+{
+    static const int core_errors[] = {
+	BadValue, BadWindow, BadMatch, BadAccess, BadAlloc
+    };
+    int codes[GESTURE_MAX_HOOKED_ERRORS];
+    Bool (*prev)(Display *, XErrorEvent *, xError *);
+    int i, n = 0;
+
+    for (i = 0; i < (int)(sizeof(core_errors) / sizeof(core_errors[0])); i++)
+	codes[n++] = core_errors[i];
+    for (i = 0; i < GestureNumberErrors; i++)
+	codes[n++] = info->codes->first_error + i;
+
+    /* same locking as _XGestureHookCoreEvents() */
+    XLockDisplay(dpy);
+    if (!priv->num_hooked_errors) {
+	for (i = 0; i < n; i++) {
+	    prev = XESetWireToError(dpy, codes[i], request_error);
+	    priv->hooked_error_code[i] = codes[i];
+	    priv->wire_to_error[i] =
+		prev != request_error ? prev : _XDefaultWireError;
+	}
+	priv->num_hooked_errors = n;
+    }
+    XUnlockDisplay(dpy);
+}
+
+Bool
+_XGestureGrabIsActive(GestureDisplayPrivPtr priv, Window w, int eventType,
+		      int num_finger)
+{
+    GestureWindowPtr win;
+
+    if (!priv->coalesce_requests || !GRAB_BIT(num_finger) ||
+	eventType < 0 || eventType >= GestureNumberEvents)
+	return False;
+
+    win = _XGestureFindWindow(priv, w, False);
+    return win && (win->grabbed[eventType] & GRAB_BIT(num_finger));
+}
+
+/* the server releases grabs on a window that goes away or is unmapped */
+void
+_XGestureForgetGrabs(GestureDisplayPrivPtr priv, Window w)
+{
+    GestureWindowPtr win;
+
+    if ((win = _XGestureFindWindow(priv, w, False))) {
+	memset(win->grabbed, 0, sizeof(win->grabbed));
+	_XGesturePruneWindow(priv, win);
+    }
+}
+
+void
+_XGestureRecordGrab(GestureDisplayPrivPtr priv, Window w, int eventType,
+		    int num_finger, Bool grabbed)
+{
+    GestureWindowPtr win;
+
+    if (!priv->coalesce_requests || !GRAB_BIT(num_finger) ||
+	eventType < 0 || eventType >= GestureNumberEvents)
+	return;
+
+    if (grabbed) {
+	if ((win = _XGestureFindWindow(priv, w, True)))
+	    win->grabbed[eventType] |= GRAB_BIT(num_finger);
+    } else if ((win = _XGestureFindWindow(priv, w, False))) {
+	win->grabbed[eventType] &= ~GRAB_BIT(num_finger);
+	_XGesturePruneWindow(priv, win);
+    }
+}
+
+Bool
+XGestureSetRequestCoalescing(Display* dpy, Bool enable)
+{
+    XExtDisplayInfo *info = _XGestureFindDisplay (dpy);
+    GestureDisplayPrivPtr priv;
+    GestureWindowPtr win, next;
+    int i;
+
+    TRACE("SetRequestCoalescing...");
+    GestureCheckExtension (dpy, info, False);
+    priv = GesturePriv(info);
+
+    if (enable) {
+	_XGestureHookCoreEvents(dpy, priv);
+	hook_errors(dpy, info, priv);
+    }
+
+    LockDisplay(dpy);
+    if (!enable) {
+	for (i = 0; i < GESTURE_WINDOW_HASH_SIZE; i++) {
+	    for (win = priv->windows[i]; win; win = next) {
+		next = win->next;
+		forget_window(priv, win);
+	    }
+	}
+    }
+    priv->coalesce_requests = enable;
+    UnlockDisplay(dpy);
+
+    return True;
+}
+
+void
+XGestureForgetWindow(Display* dpy, Window w)
+{
+    XExtDisplayInfo *info = _XGestureFindDisplay (dpy);
+    GestureDisplayPrivPtr priv;
+    GestureWindowPtr win;
+
+    GestureSimpleCheckExtension (dpy, info);
+    priv = GesturePriv(info);
+
+    LockDisplay(dpy);
+    if ((win = _XGestureFindWindow(priv, w, False)))
+	forget_window(priv, win);
+    UnlockDisplay(dpy);
+}
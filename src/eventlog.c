@@ -0,0 +1,476 @@
+/*
+ *
+ * libxgesture
+ *
+ * Contact: Sung-Jin Park <sj76.park@samsung.com>
+ *          Sangjin LEE <lsj119@samsung.com>
+ *
+ * Copyright (c) 2011 Samsung Electronics Co., Ltd All Rights Reserved 
+ *
+ * Permission to use, copy, modify, distribute, and sell this software
+ * and its documentation for any purpose is hereby granted without
+ * fee, provided that the above copyright notice appear in all copies
+ * and that both that copyright notice and this permission notice
+ * appear in supporting documentation, and that the name of Red Hat
+ * not be used in advertising or publicity pertaining to distribution
+ * of the software without specific, written prior permission.  Red
+ * Hat makes no representations about the suitability of this software
+ * for any purpose.  It is provided "as is" without express or implied
+ * warranty.
+ *
+ * THE AUTHORS DISCLAIM ALL WARRANTIES WITH REGARD TO THIS SOFTWARE,
+ * INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS, IN
+ * NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY SPECIAL, INDIRECT OR
+ * CONSEQUENTIAL DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS
+ * OF USE, DATA OR PROFITS, WHETHER IN AN ACTION OF CONTRACT,
+ * NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN
+ * CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ *
+ */
+
+/*
+ * Structure-of-arrays gesture event log.
+ *
+ * Records are appended straight from wire events, so the decode path never
+ * touches anything larger than the columns below.  Times are stored as
+ * deltas from the previous record and windows as indices into a small
+ * per-log window table.
+ */
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+#include <X11/Xlibint.h>
+#include <X11/extensions/Xext.h>
+#include <X11/extensions/extutil.h>
+#include <X11/extensions/gesture.h>
+#include <X11/extensions/gestureproto.h>
+#include "gestureint.h"
+
+#include <limits.h>
+
+#define LOG_MAGIC		0x4c454758	/* "XGEL" */
+#define LOG_FORMAT_VERSION	1
+#define LOG_MAX_WINDOWS		65535
+#define LOG_HEADER_SIZE		(5 * 4)
+
+#define PACK_XY(x, y)	((((CARD32)(CARD16)(x)) << 16) | (CARD16)(y))
+#define UNPACK_X(xy)	((short)((xy) >> 16))
+#define UNPACK_Y(xy)	((short)((xy) & 0xffff))
+
+struct _XGestureEventLog {
+    int count;
+    int capacity;
+    Time base_time;
+    Time last_time;
+
+    /* one entry per record */
+    CARD8 *type;
+    CARD8 *kind;
+    CARD8 *num_finger;
+    CARD8 *aux;
+    CARD16 *window_index;
+    CARD32 *time_delta;
+    CARD32 *xy;
+    INT32 *value[3];
+
+    /* window table */
+    Window *windows;
+    int num_windows;
+    int windows_size;
+    int last_window;
+};
+
+static Bool
+grow(XGestureEventLog *log, int capacity)
+{
+    void *p;
+    int i;
+
+#define GROW_COLUMN(col) \
+    if (!(p = Xrealloc(log->col, capacity * sizeof(*log->col)))) return False; \
+    log->col = p;
+
+    GROW_COLUMN(type);
+    GROW_COLUMN(kind);
+    GROW_COLUMN(num_finger);
+    GROW_COLUMN(aux);
+    GROW_COLUMN(window_index);
+    GROW_COLUMN(time_delta);
+    GROW_COLUMN(xy);
+    for (i = 0; i < 3; i++) {
+	GROW_COLUMN(value[i]);
+    }
+#undef GROW_COLUMN
+
+    log->capacity = capacity;
+    return True;
+}
+
+static int
+window_index(XGestureEventLog *log, Window w)
+{
+    Window *p;
+    int i;
+
+    if (log->num_windows && log->windows[log->last_window] == w)
+	return log->last_window;
+
+    for (i = 0; i < log->num_windows; i++) {
+	if (log->windows[i] == w)
+	    return log->last_window = i;
+    }
+
+    if (log->num_windows >= LOG_MAX_WINDOWS)
+	return -1;
+
+    if (log->num_windows == log->windows_size) {
+	int size = log->windows_size ? log->windows_size * 2 : 8;
+
+	if (!(p = Xrealloc(log->windows, size * sizeof(Window))))
+	    return -1;
+	log->windows = p;
+	log->windows_size = size;
+    }
+
+    log->windows[log->num_windows] = w;
+    return log->last_window = log->num_windows++;
+}
+
+static Bool
+append(XGestureEventLog *log, int type, int kind, int num_finger, int aux,
+       Window w, Time time, int x, int y, INT32 v0, INT32 v1, INT32 v2)
+{
+    int n = log->count;
+    int widx;
+
+    if (n == log->capacity && !grow(log, log->capacity * 2))
+	return False;
+
+    if ((widx = window_index(log, w)) < 0)
+	return False;
+
+    if (!n)
+	log->base_time = log->last_time = time;
+
+    log->type[n] = type;
+    log->kind[n] = kind;
+    log->num_finger[n] = num_finger;
+    log->aux[n] = aux;
+    log->window_index[n] = widx;
+    log->time_delta[n] = (CARD32)(time - log->last_time);
+    log->xy[n] = PACK_XY(x, y);
+    log->value[0][n] = v0;
+    log->value[1][n] = v1;
+    log->value[2][n] = v2;
+
+    log->last_time = time;
+    log->count++;
+
+    return True;
+}
+
+XGestureEventLog *
+XGestureEventLogCreate(int initial_capacity)
+{
+    XGestureEventLog *log;
+
+    if (initial_capacity < 16)
+	initial_capacity = 16;
+
+    if (!(log = Xcalloc(1, sizeof(XGestureEventLog))))
+	return NULL;
+
+    if (!grow(log, initial_capacity)) {
+	XGestureEventLogDestroy(log);
+	return NULL;
+    }
+
+    return log;
+}
+
+void
+XGestureEventLogDestroy(XGestureEventLog *log)
+{
+    int i;
+
+    if (!log)
+	return;
+
+    Xfree(log->type);
+    Xfree(log->kind);
+    Xfree(log->num_finger);
+    Xfree(log->aux);
+    Xfree(log->window_index);
+    Xfree(log->time_delta);
+    Xfree(log->xy);
+    for (i = 0; i < 3; i++)
+	Xfree(log->value[i]);
+    Xfree(log->windows);
+    Xfree(log);
+}
+
+void
+XGestureEventLogClear(XGestureEventLog *log)
+{
+    log->count = 0;
+    log->num_windows = 0;
+    log->last_window = 0;
+}
+
+int
+XGestureEventLogCount(XGestureEventLog *log)
+{
+    return log->count;
+}
+
+Bool
+_XGestureEventLogAppendWire(XGestureEventLog *log, int type, xEvent *wire)
+{
+    xGestureNotifyGroupEvent *wgev;
+    xGestureNotifyFlickEvent *wfev;
+    xGestureNotifyPanEvent *wpev;
+    xGestureNotifyPinchRotationEvent *wpcrev;
+    xGestureNotifyTapEvent *wtev;
+    xGestureNotifyTapNHoldEvent *wthev;
+    xGestureNotifyHoldEvent *whev;
+
+    switch (type) {
+	case GestureNotifyGroup:
+	    wgev = (xGestureNotifyGroupEvent *)wire;
+	    return append(log, type, wgev->kind, 0, 0, wgev->window, wgev->time,
+			  0, 0, wgev->groupid, wgev->num_group, 0);
+
+	case GestureNotifyFlick:
+	    wfev = (xGestureNotifyFlickEvent *)wire;
+	    return append(log, type, wfev->kind, wfev->num_finger, wfev->direction,
+			  wfev->window, wfev->time, 0, 0,
+			  wfev->distance, wfev->duration, wfev->angle);
+
+	case GestureNotifyPan:
+	    wpev = (xGestureNotifyPanEvent *)wire;
+	    return append(log, type, wpev->kind, wpev->num_finger, wpev->direction,
+			  wpev->window, wpev->time,
+			  (short int)wpev->dx, (short int)wpev->dy,
+			  wpev->distance, wpev->duration, 0);
+
+	case GestureNotifyPinchRotation:
+	    wpcrev = (xGestureNotifyPinchRotationEvent *)wire;
+	    return append(log, type, wpcrev->kind, wpcrev->num_finger, 0,
+			  wpcrev->window, wpcrev->time, wpcrev->cx, wpcrev->cy,
+			  wpcrev->zoom, wpcrev->angle, wpcrev->distance);
+
+	case GestureNotifyTap:
+	    wtev = (xGestureNotifyTapEvent *)wire;
+	    return append(log, type, wtev->kind, wtev->num_finger, wtev->tap_repeat,
+			  wtev->window, wtev->time, wtev->cx, wtev->cy,
+			  wtev->interval, 0, 0);
+
+	case GestureNotifyTapNHold:
+	    wthev = (xGestureNotifyTapNHoldEvent *)wire;
+	    return append(log, type, wthev->kind, wthev->num_finger, 0,
+			  wthev->window, wthev->time, wthev->cx, wthev->cy,
+			  wthev->interval, wthev->holdtime, 0);
+
+	case GestureNotifyHold:
+	    whev = (xGestureNotifyHoldEvent *)wire;
+	    return append(log, type, whev->kind, whev->num_finger, 0,
+			  whev->window, whev->time, whev->cx, whev->cy,
+			  whev->holdtime, 0, 0);
+    }
+
+    return False;
+}
+
+Bool
+XGestureEventLogAppendEvent(XGestureEventLog *log, int event_base,
+			    XGestureCommonEvent *ev)
+{
+    int type = ev->any.type - event_base;
+
+    switch (type) {
+	case GestureNotifyGroup:
+	    return append(log, type, ev->gev.kind, 0, 0, ev->gev.window,
+			  ev->gev.time, 0, 0, ev->gev.groupid, ev->gev.num_group, 0);
+
+	case GestureNotifyFlick:
+	    return append(log, type, ev->fev.kind, ev->fev.num_finger,
+			  ev->fev.direction, ev->fev.window, ev->fev.time, 0, 0,
+			  ev->fev.distance, ev->fev.duration, ev->fev.angle);
+
+	case GestureNotifyPan:
+	    return append(log, type, ev->pev.kind, ev->pev.num_finger,
+			  ev->pev.direction, ev->pev.window, ev->pev.time,
+			  ev->pev.dx, ev->pev.dy,
+			  ev->pev.distance, ev->pev.duration, 0);
+
+	case GestureNotifyPinchRotation:
+	    return append(log, type, ev->pcrev.kind, ev->pcrev.num_finger, 0,
+			  ev->pcrev.window, ev->pcrev.time, ev->pcrev.cx, ev->pcrev.cy,
+			  ev->pcrev.zoom, ev->pcrev.angle, ev->pcrev.distance);
+
+	case GestureNotifyTap:
+	    return append(log, type, ev->tev.kind, ev->tev.num_finger,
+			  ev->tev.tap_repeat, ev->tev.window, ev->tev.time,
+			  ev->tev.cx, ev->tev.cy, ev->tev.interval, 0, 0);
+
+	case GestureNotifyTapNHold:
+	    return append(log, type, ev->thev.kind, ev->thev.num_finger, 0,
+			  ev->thev.window, ev->thev.time, ev->thev.cx, ev->thev.cy,
+			  ev->thev.interval, ev->thev.holdtime, 0);
+
+	case GestureNotifyHold:
+	    return append(log, type, ev->hev.kind, ev->hev.num_finger, 0,
+			  ev->hev.window, ev->hev.time, ev->hev.cx, ev->hev.cy,
+			  ev->hev.holdtime, 0, 0);
+    }
+
+    return False;
+}
+
+void
+XGestureEventLogBegin(XGestureEventLog *log, XGestureLogIter *iter)
+{
+    iter->index = 0;
+    iter->time = log->base_time;
+}
+
+Bool
+XGestureEventLogNext(XGestureEventLog *log, XGestureLogIter *iter,
+		     XGestureLogRecord *rec)
+{
+    int n = iter->index;
+
+    if (n < 0 || n >= log->count)
+	return False;
+
+    /* the server clock is 32 bits: a step back or a wrap is a modular delta */
+    iter->time = (CARD32)(iter->time + log->time_delta[n]);
+    iter->index++;
+
+    rec->type = log->type[n];
+    rec->kind = log->kind[n];
+    rec->num_finger = log->num_finger[n];
+    rec->aux = log->aux[n];
+    rec->window = log->windows[log->window_index[n]];
+    rec->time = iter->time;
+    rec->x = UNPACK_X(log->xy[n]);
+    rec->y = UNPACK_Y(log->xy[n]);
+    rec->value[0] = log->value[0][n];
+    rec->value[1] = log->value[1][n];
+    rec->value[2] = log->value[2][n];
+
+    return True;
+}
+
+/*
+ * Serialized layout, in host byte order:
+ *
+ *   CARD32 magic, version, count, num_windows, base_time
+ *   CARD32 windows[num_windows]
+ *   CARD8  type[count], kind[count], num_finger[count], aux[count]
+ *   CARD16 window_index[count]
+ *   CARD32 time_delta[count], xy[count]
+ *   INT32  value0[count], value1[count], value2[count]
+ */
+static int
+serialized_size(int count, int num_windows)
+{
+    return LOG_HEADER_SIZE + num_windows * 4 + count * (4 * 1 + 2 + 5 * 4);
+}
+
+#define PUT(ptr, src, len) do { memcpy(ptr, src, len); ptr += (len); } while (0)
+#define GET(dst, ptr, len) do { memcpy(dst, ptr, len); ptr += (len); } while (0)
+
+int
+XGestureEventLogSerialize(XGestureEventLog *log, char *buf, int size)
+{
+    int needed = serialized_size(log->count, log->num_windows);
+    CARD32 header[5];
+    CARD32 w;
+    char *p = buf;
+    int n = log->count;
+    int i;
+
+    if (!buf || size < needed)
+	return needed;
+
+    header[0] = LOG_MAGIC;
+    header[1] = LOG_FORMAT_VERSION;
+    header[2] = n;
+    header[3] = log->num_windows;
+    header[4] = log->base_time;
+    PUT(p, header, sizeof(header));
+
+    for (i = 0; i < log->num_windows; i++) {
+	w = log->windows[i];
+	PUT(p, &w, 4);
+    }
+
+    PUT(p, log->type, n);
+    PUT(p, log->kind, n);
+    PUT(p, log->num_finger, n);
+    PUT(p, log->aux, n);
+    PUT(p, log->window_index, n * 2);
+    PUT(p, log->time_delta, n * 4);
+    PUT(p, log->xy, n * 4);
+    for (i = 0; i < 3; i++)
+	PUT(p, log->value[i], n * 4);
+
+    return needed;
+}
+
+XGestureEventLog *
+XGestureEventLogLoad(const char *buf, int size)
+{
+    XGestureEventLog *log;
+    const char *p = buf;
+    CARD32 header[5];
+    CARD32 w;
+    int n, i;
+
+    if (!buf || size < LOG_HEADER_SIZE)
+	return NULL;
+
+    GET(header, p, sizeof(header));
+    if (header[0] != LOG_MAGIC || header[1] != LOG_FORMAT_VERSION ||
+	header[2] > INT_MAX / 32 || header[3] > LOG_MAX_WINDOWS ||
+	size < serialized_size(header[2], header[3]))
+	return NULL;
+
+    n = header[2];
+    if (!(log = XGestureEventLogCreate(n)))
+	return NULL;
+
+    for (i = 0; i < (int)header[3]; i++) {
+	GET(&w, p, 4);
+	if (window_index(log, w) < 0) {
+	    XGestureEventLogDestroy(log);
+	    return NULL;
+	}
+    }
+
+    GET(log->type, p, n);
+    GET(log->kind, p, n);
+    GET(log->num_finger, p, n);
+    GET(log->aux, p, n);
+    GET(log->window_index, p, n * 2);
+    GET(log->time_delta, p, n * 4);
+    GET(log->xy, p, n * 4);
+    for (i = 0; i < 3; i++)
+	GET(log->value[i], p, n * 4);
+
+    for (i = 0; i < n; i++) {
+	if (log->window_index[i] >= log->num_windows) {
+	    XGestureEventLogDestroy(log);
+	    return NULL;
+	}
+	log->last_time += log->time_delta[i];
+    }
+
+    log->count = n;
+    log->base_time = header[4];
+    log->last_time = (CARD32)(log->last_time + header[4]);
+
+    return log;
+}
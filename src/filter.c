@@ -0,0 +1,220 @@
+/*
+ *
+ * libxgesture
+ *
+ * Contact: Sung-Jin Park <sj76.park@samsung.com>
+ *          Sangjin LEE <lsj119@samsung.com>
+ *
+ * Copyright (c) 2011 Samsung Electronics Co., Ltd All Rights Reserved 
+ *
+ * Permission to use, copy, modify, distribute, and sell this software
+ * and its documentation for any purpose is hereby granted without
+ * fee, provided that the above copyright notice appear in all copies
+ * and that both that copyright notice and this permission notice
+ * appear in supporting documentation, and that the name of Red Hat
+ * not be used in advertising or publicity pertaining to distribution
+ * of the software without specific, written prior permission.  Red
+ * Hat makes no representations about the suitability of this software
+ * for any purpose.  It is provided "as is" without express or implied
+ * warranty.
+ *
+ * THE AUTHORS DISCLAIM ALL WARRANTIES WITH REGARD TO THIS SOFTWARE,
+ * INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS, IN
+ * NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY SPECIAL, INDIRECT OR
+ * CONSEQUENTIAL DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS
+ * OF USE, DATA OR PROFITS, WHETHER IN AN ACTION OF CONTRACT,
+ * NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN
+ * CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ *
+ */
+
+/*
+ * Adaptive smoothing of gesture values.
+ *
+ * A One Euro filter (Casiez et al., CHI 2012) per channel: a low-pass whose
+ * cutoff rises with the speed of the signal, so slow motion is steadied
+ * while fast motion keeps its latency low.  Each channel keeps three values
+ * of state and is updated in constant time while the event is decoded.
+ *
+ * Pan is filtered on the accumulated position and delivered as the delta
+ * of the filtered position, so rounding never makes the pan drift; the lag
+ * still held by the filter is delivered with GestureEnd, so the pan adds up
+ * to the full finger travel.
+ * PinchRotation zoom and angle are filtered directly.
+ */
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+#include <X11/Xlibint.h>
+#include <X11/extensions/Xext.h>
+#include <X11/extensions/extutil.h>
+#include <X11/extensions/gesture.h>
+#include "gestureint.h"
+
+#include <math.h>
+
+typedef struct {
+    double x;			/* filtered value */
+    double dx;			/* filtered derivative */
+    double raw;			/* previous raw value */
+} FilterChannel;
+
+typedef struct _GestureFilterRec {
+    double min_cutoff;		/* Hz */
+    double beta;
+    double d_cutoff;		/* Hz */
+
+    Bool primed;
+    Time last_time;
+    FilterChannel ch[2];
+
+    /* pan: accumulated raw position and the delivered filtered position */
+    int pos[2];
+    int out[2];
+} GestureFilterRec;
+
+static double
+alpha(double cutoff, double te)
+{
+    double tau = 1.0 / (2 * M_PI * cutoff);
+
+    return 1.0 / (1.0 + tau / te);
+}
+
+static double
+filter_value(GestureFilterPtr f, FilterChannel *ch, double value, double te)
+{
+    double a, cutoff;
+
+    ch->dx += alpha(f->d_cutoff, te) * ((value - ch->raw) / te - ch->dx);
+    cutoff = f->min_cutoff + f->beta * fabs(ch->dx);
+    a = alpha(cutoff, te);
+    ch->x += a * (value - ch->x);
+    ch->raw = value;
+
+    return ch->x;
+}
+
+static void
+prime(GestureFilterPtr f, double v0, double v1, Time time)
+{
+    f->ch[0].x = f->ch[0].raw = v0;
+    f->ch[1].x = f->ch[1].raw = v1;
+    f->ch[0].dx = f->ch[1].dx = 0;
+    f->last_time = time;
+    f->primed = True;
+}
+
+void
+_XGestureFilterApply(GestureWindowPtr win, int type, XEvent *event)
+{
+    XGestureCommonEvent *ev = (XGestureCommonEvent *)event;
+    GestureFilterPtr f;
+    double te;
+    int i, x;
+
+    if (type < 0 || type >= GestureNumberEvents || !(f = win->filters[type]))
+	return;
+
+    if (!f->primed || ev->any.kind == GestureBegin) {
+	if (type == GestureNotifyPan) {
+	    f->pos[0] = f->out[0] = ev->pev.dx;
+	    f->pos[1] = f->out[1] = ev->pev.dy;
+	    prime(f, f->pos[0], f->pos[1], ev->any.time);
+	} else {
+	    prime(f, ev->pcrev.zoom, ev->pcrev.angle, ev->any.time);
+	}
+	return;
+    }
+
+    /* seconds since the previous sample, at least a millisecond */
+    te = (INT32)(ev->any.time - f->last_time) > 0 ?
+	(CARD32)(ev->any.time - f->last_time) / 1000.0 : 0.001;
+    f->last_time = ev->any.time;
+
+    if (type == GestureNotifyPan) {
+	f->pos[0] += ev->pev.dx;
+	f->pos[1] += ev->pev.dy;
+	if (ev->any.kind == GestureEnd) {
+	    /* release what the filter still holds back */
+	    ev->pev.dx = f->pos[0] - f->out[0];
+	    ev->pev.dy = f->pos[1] - f->out[1];
+	    f->out[0] = f->pos[0];
+	    f->out[1] = f->pos[1];
+	    f->primed = False;
+	    return;
+	}
+	for (i = 0; i < 2; i++) {
+	    x = (int)lround(filter_value(f, &f->ch[i], f->pos[i], te));
+	    if (i == 0)
+		ev->pev.dx = x - f->out[0];
+	    else
+		ev->pev.dy = x - f->out[1];
+	    f->out[i] = x;
+	}
+    } else {
+	ev->pcrev.zoom = (XFixed)lround(filter_value(f, &f->ch[0],
+						     ev->pcrev.zoom, te));
+	ev->pcrev.angle = (XFixed)lround(filter_value(f, &f->ch[1],
+						      ev->pcrev.angle, te));
+    }
+}
+
+GestureFilterPtr
+_XGestureFilterCreate(double min_cutoff, double beta, double d_cutoff)
+{
+    GestureFilterPtr f;
+
+    if (min_cutoff <= 0 || beta < 0 || d_cutoff <= 0)
+	return NULL;
+    if (!(f = Xcalloc(1, sizeof(GestureFilterRec))))
+	return NULL;
+    f->min_cutoff = min_cutoff;
+    f->beta = beta;
+    f->d_cutoff = d_cutoff;
+
+    return f;
+}
+
+void
+_XGestureFilterFree(GestureFilterPtr filter)
+{
+    Xfree(filter);
+}
+
+Bool
+XGestureSetFilter(Display* dpy, Window w, int eventType,
+		  double min_cutoff, double beta, double d_cutoff)
+{
+    XExtDisplayInfo *info = _XGestureFindDisplay (dpy);
+    GestureDisplayPrivPtr priv;
+    GestureWindowPtr win;
+    GestureFilterPtr f = NULL;
+
+    TRACE("SetFilter...");
+    GestureCheckExtension (dpy, info, False);
+    priv = GesturePriv(info);
+
+    if (eventType != GestureNotifyPan && eventType != GestureNotifyPinchRotation)
+	return False;
+
+    /* a non-positive cutoff removes the filter */
+    if (min_cutoff > 0 && !(f = _XGestureFilterCreate(min_cutoff, beta,
+						      d_cutoff)))
+	return False;
+
+    LockDisplay(dpy);
+    win = _XGestureFindWindow(priv, w, f != NULL);
+    if (!win) {
+	UnlockDisplay(dpy);
+	_XGestureFilterFree(f);
+	return f == NULL;
+    }
+    _XGestureFilterFree(win->filters[eventType]);
+    win->filters[eventType] = f;
+    _XGesturePruneWindow(priv, win);
+    UnlockDisplay(dpy);
+
+    return True;
+}
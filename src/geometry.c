@@ -0,0 +1,193 @@
+/*
+ *
+ * libxgesture
+ *
+ * Contact: Sung-Jin Park <sj76.park@samsung.com>
+ *          Sangjin LEE <lsj119@samsung.com>
+ *
+ * Copyright (c) 2011 Samsung Electronics Co., Ltd All Rights Reserved 
+ *
+ * Permission to use, copy, modify, distribute, and sell this software
+ * and its documentation for any purpose is hereby granted without
+ * fee, provided that the above copyright notice appear in all copies
+ * and that both that copyright notice and this permission notice
+ * appear in supporting documentation, and that the name of Red Hat
+ * not be used in advertising or publicity pertaining to distribution
+ * of the software without specific, written prior permission.  Red
+ * Hat makes no representations about the suitability of this software
+ * for any purpose.  It is provided "as is" without express or implied
+ * warranty.
+ *
+ * THE AUTHORS DISCLAIM ALL WARRANTIES WITH REGARD TO THIS SOFTWARE,
+ * INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS, IN
+ * NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY SPECIAL, INDIRECT OR
+ * CONSEQUENTIAL DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS
+ * OF USE, DATA OR PROFITS, WHETHER IN AN ACTION OF CONTRACT,
+ * NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN
+ * CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ *
+ */
+
+/*
+ * Client side window geometry cache.
+ *
+ * Gesture centers arrive in root coordinates.  For windows registered with
+ * XGestureTrackWindowGeometry() the root position of the window is kept
+ * current from ConfigureNotify and ReparentNotify, so the decoder can fill
+ * in window relative coordinates without XTranslateCoordinates().
+ *
+ * Real ConfigureNotify events are relative to the parent and are only used
+ * while the parent is the root.  Reparented top-levels are followed through
+ * the synthetic ConfigureNotify the window manager sends on every move
+ * (ICCCM 4.1.5), which always carries root coordinates.
+ */
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+#include <X11/Xlibint.h>
+#include <X11/extensions/Xext.h>
+#include <X11/extensions/extutil.h>
+#include <X11/extensions/gesture.h>
+#include "gestureint.h"
+
+void
+_XGestureGeometryCoreEvent(GestureDisplayPrivPtr priv, XEvent *event)
+{
+    GestureWindowPtr win;
+
+    switch (event->type) {
+	case ConfigureNotify:
+	    win = _XGestureFindWindow(priv, event->xconfigure.window, False);
+	    if (!win || !win->track_geometry)
+		return;
+	    win->border_width = event->xconfigure.border_width;
+	    if (event->xconfigure.send_event ||
+		(win->root && win->parent == win->root)) {
+		win->root_x = event->xconfigure.x + win->border_width;
+		win->root_y = event->xconfigure.y + win->border_width;
+		win->geometry_valid = True;
+	    }
+	    break;
+
+	case ReparentNotify:
+	    win = _XGestureFindWindow(priv, event->xreparent.window, False);
+	    if (!win || !win->track_geometry)
+		return;
+	    win->parent = event->xreparent.parent;
+	    if (win->parent == win->root) {
+		win->root_x = event->xreparent.x + win->border_width;
+		win->root_y = event->xreparent.y + win->border_width;
+		win->geometry_valid = True;
+	    } else {
+		/* wait for the window manager's synthetic ConfigureNotify */
+		win->geometry_valid = False;
+	    }
+	    break;
+    }
+}
+
+void
+_XGestureGeometryTranslate(GestureWindowPtr win, int type, XEvent *event)
+{
+    XGestureCommonEvent *ev = (XGestureCommonEvent *)event;
+    Bool valid = win && win->geometry_valid;
+    int dx = valid ? win->root_x : 0;
+    int dy = valid ? win->root_y : 0;
+
+    switch (type) {
+	case GestureNotifyPinchRotation:
+	    ev->pcrev.has_local = valid;
+	    ev->pcrev.local_x = ev->pcrev.cx - dx;
+	    ev->pcrev.local_y = ev->pcrev.cy - dy;
+	    break;
+	case GestureNotifyTap:
+	    ev->tev.has_local = valid;
+	    ev->tev.local_x = ev->tev.cx - dx;
+	    ev->tev.local_y = ev->tev.cy - dy;
+	    break;
+	case GestureNotifyTapNHold:
+	    ev->thev.has_local = valid;
+	    ev->thev.local_x = ev->thev.cx - dx;
+	    ev->thev.local_y = ev->thev.cy - dy;
+	    break;
+	case GestureNotifyHold:
+	    ev->hev.has_local = valid;
+	    ev->hev.local_x = ev->hev.cx - dx;
+	    ev->hev.local_y = ev->hev.cy - dy;
+	    break;
+    }
+}
+
+Bool
+XGestureTrackWindowGeometry(Display* dpy, Window w, Bool track)
+{
+    XExtDisplayInfo *info = _XGestureFindDisplay (dpy);
+    GestureDisplayPrivPtr priv;
+    GestureWindowPtr win;
+    Window root, parent, child, *children;
+    unsigned int nchildren;
+    int x, y;
+
+    TRACE("TrackWindowGeometry...");
+    GestureCheckExtension (dpy, info, False);
+    priv = GesturePriv(info);
+
+    if (!track) {
+	LockDisplay(dpy);
+	if ((win = _XGestureFindWindow(priv, w, False))) {
+	    win->track_geometry = win->geometry_valid = False;
+	    _XGesturePruneWindow(priv, win);
+	}
+	UnlockDisplay(dpy);
+	return True;
+    }
+
+    _XGestureHookCoreEvents(dpy, priv);
+
+    LockDisplay(dpy);
+    win = _XGestureFindWindow(priv, w, True);
+    if (win && !win->track_geometry) {
+	win->track_geometry = True;
+	win->geometry_valid = False;
+	win->border_width = 0;
+    }
+    UnlockDisplay(dpy);
+    if (!win)
+	return False;
+
+    /* seed the cache; these are the only round-trips the cache costs */
+    if (!XQueryTree(dpy, w, &root, &parent, &children, &nchildren))
+	goto fail;
+    if (children)
+	XFree(children);
+    if (!XTranslateCoordinates(dpy, w, root, 0, 0, &x, &y, &child))
+	goto fail;
+
+    LockDisplay(dpy);
+    if ((win = _XGestureFindWindow(priv, w, False)) && win->track_geometry) {
+	win->root = root;
+	win->parent = parent;
+	/* an event decoded meanwhile is newer than the reply */
+	if (!win->geometry_valid) {
+	    win->root_x = x;
+	    win->root_y = y;
+	    win->geometry_valid = True;
+	}
+    }
+    UnlockDisplay(dpy);
+    TRACE("TrackWindowGeometry... return True");
+
+    return True;
+
+fail:
+    LockDisplay(dpy);
+    if ((win = _XGestureFindWindow(priv, w, False))) {
+	win->track_geometry = win->geometry_valid = False;
+	_XGesturePruneWindow(priv, win);
+    }
+    UnlockDisplay(dpy);
+    TRACE("TrackWindowGeometry... return False");
+
+    return False;
+}
@@ -38,29 +38,20 @@
 #include <X11/extensions/extutil.h>
 #include <X11/extensions/gesture.h>
 #include <X11/extensions/gestureproto.h>
-
-#include <stdio.h>
-#ifdef __XGESTURE_LIB_DEBUG__
-#define TRACE(msg)  fprintf(stderr, "[X11][GestureExt] %s\n", msg);
-#else
-#define TRACE(msg)
-#endif
-
-extern const void* GetVersionInfo(Display *dpy);
+#include "gestureint.h"
 
 static XExtensionInfo _gesture_info_data;
 static XExtensionInfo *gesture_info = &_gesture_info_data;
 static char *gesture_extension_name = GESTURE_EXT_NAME;
 
-#define GestureCheckExtension(dpy,i,val) \
-  XextCheckExtension (dpy, i, gesture_extension_name, val)
-
 //hooking functions
 static char    *error_string(Display *dpy, int code, XExtCodes *codes,
 			     char *buf, int n);
 static int close_display(Display *dpy, XExtCodes *extCodes);
 static Bool wire_to_event(Display *dpy, XEvent *event, xEvent *wire);
 static Status event_to_wire(Display *dpy, XEvent *event, xEvent *wire);
+static Status gesture_event_to_wire(XExtDisplayInfo *info, XEvent *event,
+				    xEvent *wire);
 
 static /* const */ XExtensionHooks gesture_extension_hooks = {
     NULL,				/* create_gc */
@@ -82,47 +73,119 @@ static char    *gesture_error_list[] = {
     "OperationNotSupported",
 };
 
-typedef struct _GestureVersionInfoRec {
-    short major;
-    short minor;
-    int num_errors;
-} GestureVersionInfo;
-
-#define GET_VERSION(info) ((info) ? (const GestureVersionInfo*)(info)->data : NULL)
-#define IS_VERSION_SUPPORTED(info) (!!GET_VERSION(info))
-
-static XEXT_GENERATE_FIND_DISPLAY (find_display, gesture_info,
-                                   gesture_extension_name,
-                                   &gesture_extension_hooks,
-                                   GestureNumberEvents, NULL)
+/*
+ * XextFindDisplay() serializes every lookup on the global Xlib lock.  Each
+ * thread keeps a snapshot of its last lookup instead, validated against a
+ * generation counter that close_display() bumps, so the steady state of a
+ * gesture call takes no global lock at all.
+ */
+#if defined(__GNUC__)
+#define GESTURE_HAVE_TLS_CACHE
+static __thread Display *cached_dpy;
+static __thread XExtDisplayInfo *cached_info;
+static __thread unsigned int cached_generation;
+static unsigned int display_generation;
+#endif
 
-static XEXT_GENERATE_CLOSE_DISPLAY (close_display, gesture_info)
+/*
+ * A Known version never changes for the life of the display, so
+ * XGestureQueryVersion() answers from it without the display lock.  The
+ * release store publishes the version numbers written just before it.
+ */
+#if defined(__GNUC__)
+#define version_known_unlocked(priv) \
+    (__atomic_load_n(&(priv)->version_state, __ATOMIC_ACQUIRE) == \
+     GestureVersionKnown)
+#define set_version_known(priv) \
+    __atomic_store_n(&(priv)->version_state, GestureVersionKnown, \
+		     __ATOMIC_RELEASE)
+#else
+#define version_known_unlocked(priv) False
+#define set_version_known(priv) ((priv)->version_state = GestureVersionKnown)
+#endif
 
-static
-XExtDisplayInfo *find_display_create_optional(Display *dpy, Bool create)
+static XExtDisplayInfo *
+find_display (Display *dpy)
 {
     XExtDisplayInfo *dpyinfo;
+    GestureDisplayPrivPtr priv;
+#ifdef GESTURE_HAVE_TLS_CACHE
+    unsigned int generation = __atomic_load_n(&display_generation,
+					      __ATOMIC_ACQUIRE);
+
+    if (cached_dpy == dpy && cached_generation == generation)
+        return cached_info;
+#endif
 
     if (!gesture_info) {
         if (!(gesture_info = XextCreateExtension())) return NULL;
     }
 
-    if (!(dpyinfo = XextFindDisplay (gesture_info, dpy)) && create) {
-        dpyinfo = XextAddDisplay(gesture_info, dpy,
-                                 GESTURE_EXT_NAME,
-                                 &gesture_extension_hooks,
-                                 GestureNumberErrors,
-                                 (XPointer)GetVersionInfo(dpy));
+    if (!(dpyinfo = XextFindDisplay (gesture_info, dpy))) {
+        /* the version is negotiated lazily, see XGestureQueryVersion() */
+        priv = Xcalloc(1, sizeof(GestureDisplayPrivRec));
+        if (!priv) return NULL;
+        priv->version_state = GestureVersionUnknown;
+        _XGestureNotifyInit(priv);
+
+        dpyinfo = XextAddDisplay (gesture_info, dpy,
+                                  gesture_extension_name,
+                                  &gesture_extension_hooks,
+                                  GestureNumberEvents,
+                                  (XPointer)priv);
+        if (!dpyinfo) Xfree(priv);
     }
 
+#ifdef GESTURE_HAVE_TLS_CACHE
+    if (dpyinfo) {
+        cached_dpy = dpy;
+        cached_info = dpyinfo;
+        cached_generation = generation;
+    }
+#endif
+
     return dpyinfo;
 }
 
+XExtDisplayInfo *
+_XGestureFindDisplay (Display *dpy)
+{
+    return find_display (dpy);
+}
+
+static int
+close_display(Display *dpy, XExtCodes *codes)
+{
+    XExtDisplayInfo *info = XextFindDisplay (gesture_info, dpy);
+    GestureDisplayPrivPtr priv;
+
+#ifdef GESTURE_HAVE_TLS_CACHE
+    /* invalidate every thread's snapshot before the info goes away */
+    __atomic_add_fetch(&display_generation, 1, __ATOMIC_RELEASE);
+#endif
+
+    if (info && (priv = GesturePriv(info))) {
+        if (priv->version_state == GestureVersionPending)
+            DeqAsyncHandler(dpy, &priv->version_async);
+        _XGestureFreeWindows(priv);
+        _XGestureNotifyClose(priv);
+        _XGesturePriorityFree(priv->priority);
+        _XGestureTelemetryClose(priv->telemetry);
+        Xfree(priv);
+        info->data = NULL;
+    }
+
+    return XextRemoveDisplay (gesture_info, dpy);
+}
+
 static
 char *error_string(Display *dpy, int code, XExtCodes *codes, char *buf, int n)
 {
-    XExtDisplayInfo *info = find_display_create_optional(dpy, False);
-    int nerr = IS_VERSION_SUPPORTED(info) ? GET_VERSION(info)->num_errors : 0;
+    XExtDisplayInfo *info = XextFindDisplay (gesture_info, dpy);
+    int nerr = (info && info->data) ? GesturePriv(info)->num_errors : 0;
+
+    if (nerr > (int)(sizeof(gesture_error_list) / sizeof(gesture_error_list[0])))
+	nerr = sizeof(gesture_error_list) / sizeof(gesture_error_list[0]);
 
     code -= codes->first_error;
     if (code >= 0 && code < nerr) {
@@ -135,6 +198,50 @@ char *error_string(Display *dpy, int code, XExtCodes *codes, char *buf, int n)
     return (char *)0;
 }
 
+/*
+ * Called with the display locked once a gesture event has been decoded,
+ * feeds the library side consumers attached to this display.
+ */
+static void
+decoded_event (Display *dpy, XExtDisplayInfo *info, XEvent *event, xEvent *wire)
+{
+    GestureDisplayPrivPtr priv = GesturePriv(info);
+    int type = wire->u.u.type - info->codes->first_event;
+    GestureWindowPtr win;
+
+    if (!priv)
+	return;
+
+    if (priv->event_log)
+	_XGestureEventLogAppendWire(priv->event_log, type, wire);
+
+    if (priv->notify_fd[1] >= 0)
+	_XGestureNotifyEvent(priv);
+
+    if (priv->telemetry)
+	_XGestureTelemetryRecord(priv->telemetry, type, event);
+
+    if (type == GestureNotifyGroup)
+	_XGestureGroupUpdate(priv, event);
+
+    win = _XGestureFindWindow(priv, ((XGestureCommonEvent *)event)->any.window,
+			      False);
+
+    /* always run, so the added event fields are never left uninitialized */
+    _XGestureGeometryTranslate(win, type, event);
+    _XGestureRegionsResolve(win, type, event);
+    _XGestureGroupStamp(win, type, event);
+
+    if (!win)
+	return;
+
+    /* smooth first, the history records what the client is given */
+    _XGestureFilterApply(win, type, event);
+
+    if (win->history)
+	_XGestureHistoryAdd(win->history, type, event);
+}
+
 static Bool
 wire_to_event (Display *dpy, XEvent *event, xEvent *wire)
 {
@@ -190,7 +297,7 @@ wire_to_event (Display *dpy, XEvent *event, xEvent *wire)
 			fprintf(stderr, "window=0x%x\n", gev->window);
 			fprintf(stderr, "time=%d\n", gev->time);
 #endif//__XGESTURE_LIB_DEBUG__
-			return True;
+			break;
 
 	    case GestureNotifyFlick:
 			fev = (XGestureNotifyFlickEvent *)event;
@@ -226,7 +333,7 @@ wire_to_event (Display *dpy, XEvent *event, xEvent *wire)
 			fprintf(stderr, "window=0x%x\n", fev->window);
 			fprintf(stderr, "time=%d\n", fev->time);
 #endif//__XGESTURE_LIB_DEBUG__
-			return True;
+			break;
 
 	    case GestureNotifyPan:
 			pev = (XGestureNotifyPanEvent *)event;
@@ -263,7 +370,7 @@ wire_to_event (Display *dpy, XEvent *event, xEvent *wire)
 			fprintf(stderr, "dx:%d, dy:%d\n", pev->dx, pev->dy);
 			fprintf(stderr, "time=%d\n", pev->time);
 #endif//__XGESTURE_LIB_DEBUG__
-			return True;
+			break;
 
 	    case GestureNotifyPinchRotation:
 			pcrev = (XGestureNotifyPinchRotationEvent *)event;
@@ -300,7 +407,7 @@ wire_to_event (Display *dpy, XEvent *event, xEvent *wire)
 			fprintf(stderr, "cx:%d, cy:%d\n", pcrev->cx, pcrev->cy);
 			fprintf(stderr, "time=%d\n", pcrev->time);
 #endif//__XGESTURE_LIB_DEBUG__
-			return True;
+			break;
 
 	    case GestureNotifyTap:
 			tev = (XGestureNotifyTapEvent *)event;
@@ -332,7 +439,7 @@ wire_to_event (Display *dpy, XEvent *event, xEvent *wire)
 			fprintf(stderr, "cx:%d, cy:%d\n", tev->cx, tev->cy);
 			fprintf(stderr, "time=%d, interval=%d\n", tev->time, tev->interval);
 #endif//__XGESTURE_LIB_DEBUG__
-			return True;
+			break;
 
 	    case GestureNotifyTapNHold:
 			thev = (XGestureNotifyTapNHoldEvent *)event;
@@ -363,7 +470,7 @@ wire_to_event (Display *dpy, XEvent *event, xEvent *wire)
 			fprintf(stderr, "cx:%d, cy:%d\n", thev->cx, thev->cy);
 			fprintf(stderr, "time=%d\n", thev->time);
 #endif//__XGESTURE_LIB_DEBUG__
-			return True;
+			break;
 
 	    case GestureNotifyHold:
 			hev = (XGestureNotifyHoldEvent *)event;
@@ -394,10 +501,20 @@ wire_to_event (Display *dpy, XEvent *event, xEvent *wire)
 			fprintf(stderr, "cx:%d, cy:%d\n", hev->cx, hev->cy);
 			fprintf(stderr, "time=%d\n", hev->time);
 #endif//__XGESTURE_LIB_DEBUG__
-			return True;
+			break;
+
+	    default:
+			return False;
     }
 
-    return False;
+    decoded_event (dpy, info, event, wire);
+
+    /* queued for XGestureNextPriorityEvent(), keep it out of the Xlib queue */
+    if (GesturePriv(info)->priority &&
+	_XGesturePriorityEnqueue(dpy, GesturePriv(info)->priority, event))
+	return False;
+
+    return True;
 }
 
 static Status
@@ -405,6 +522,16 @@ event_to_wire (Display *dpy, XEvent *event, xEvent *wire)
 {
     XExtDisplayInfo *info = find_display (dpy);
 
+    GestureCheckExtension (dpy, info, False);
+
+    return gesture_event_to_wire (info, event, wire);
+}
+
+/* Shared by the event_to_wire hook and XGestureSendEvents() so that a
+ * batch of events only resolves the extension info once. */
+static Status
+gesture_event_to_wire (XExtDisplayInfo *info, XEvent *event, xEvent *wire)
+{
     XGestureNotifyGroupEvent *gev;
     xGestureNotifyGroupEvent *wgev;
     XGestureNotifyFlickEvent *fev;
@@ -419,8 +546,6 @@ event_to_wire (Display *dpy, XEvent *event, xEvent *wire)
     xGestureNotifyTapNHoldEvent *wthev;
     XGestureNotifyHoldEvent *hev;
     xGestureNotifyHoldEvent *whev;
-    GestureCheckExtension (dpy, info, False);
-
 
 #ifdef __XGESTURE_LIB_DEBUG__
     XGestureCommonEvent *xce = (XGestureCommonEvent *)event;
@@ -668,29 +793,132 @@ Bool XGestureQueryExtension (Display *dpy, int *event_basep, int *error_basep)
     }
 }
 
+/*
+ * Record a negotiated version.  The protocol has a single error set so far,
+ * so a server known to speak it has every error we can name; until then
+ * error_string() claims none of the codes.
+ */
+static void
+version_known(GestureDisplayPrivPtr priv, int major, int minor, int patch)
+{
+    priv->major_version = major;
+    priv->minor_version = minor;
+    priv->patch_version = patch;
+    priv->num_errors = sizeof(gesture_error_list) / sizeof(gesture_error_list[0]);
+    set_version_known(priv);
+}
+
+static Bool
+version_handler(Display *dpy, xReply *rep, char *buf, int len, XPointer data)
+{
+    GestureDisplayPrivPtr priv = (GestureDisplayPrivPtr)data;
+    xGestureQueryVersionReply replbuf;
+    xGestureQueryVersionReply *repl;
+
+    if (dpy->last_request_read != priv->version_seq)
+	return False;
+
+    DeqAsyncHandler(dpy, &priv->version_async);
+
+    /* nobody is waiting for this reply, so swallow a failure too */
+    if (rep->generic.type == X_Error) {
+	priv->version_state = GestureVersionFailed;
+	return True;
+    }
+
+    repl = (xGestureQueryVersionReply *)
+	_XGetAsyncReply(dpy, (char *)&replbuf, rep, buf, len,
+			(sizeof(xGestureQueryVersionReply) - sizeof(xReply)) >> 2,
+			True);
+    version_known(priv, repl->majorVersion, repl->minorVersion,
+		  repl->patchVersion);
+
+    return True;
+}
+
+Bool XGesturePrefetchVersion(Display* dpy)
+{
+    XExtDisplayInfo *info = find_display (dpy);
+    GestureDisplayPrivPtr priv;
+    xGestureQueryVersionReq *req;
+
+    TRACE("PrefetchVersion...");
+    GestureCheckExtension (dpy, info, False);
+    priv = GesturePriv(info);
+
+    LockDisplay(dpy);
+    if (priv->version_state == GestureVersionKnown ||
+	priv->version_state == GestureVersionPending) {
+	UnlockDisplay(dpy);
+	return True;
+    }
+
+    /* queue the request only; it goes out with the next flush */
+    GetReq(GestureQueryVersion, req);
+    req->reqType = info->codes->major_opcode;
+    req->gestureReqType = X_GestureQueryVersion;
+
+    priv->version_seq = dpy->request;
+    priv->version_async.next = dpy->async_handlers;
+    priv->version_async.handler = version_handler;
+    priv->version_async.data = (XPointer)priv;
+    dpy->async_handlers = &priv->version_async;
+    priv->version_state = GestureVersionPending;
+    UnlockDisplay(dpy);
+    SyncHandle();
+    TRACE("PrefetchVersion... return True");
+
+    return True;
+}
+
 Bool XGestureQueryVersion(Display* dpy, int* majorVersion, int* minorVersion,
 			  int* patchVersion)
 {
     XExtDisplayInfo *info = find_display (dpy);
+    GestureDisplayPrivPtr priv;
     xGestureQueryVersionReply rep;
     xGestureQueryVersionReq *req;
 
     TRACE("QueryVersion...");
     GestureCheckExtension (dpy, info, False);
+    priv = GesturePriv(info);
+
+    if (version_known_unlocked(priv)) {
+	*majorVersion = priv->major_version;
+	*minorVersion = priv->minor_version;
+	*patchVersion = priv->patch_version;
+	TRACE("QueryVersion... return True");
+	return True;
+    }
 
     LockDisplay(dpy);
-    GetReq(GestureQueryVersion, req);
-    req->reqType = info->codes->major_opcode;
-    req->gestureReqType = X_GestureQueryVersion;
-    if (!_XReply(dpy, (xReply *)&rep, 0, xFalse)) {
+    if (priv->version_state == GestureVersionPending) {
+	/* a prefetched reply is in flight; its outcome is this call's */
+	UnlockDisplay(dpy);
+	XSync(dpy, False);
+	LockDisplay(dpy);
+    } else if (priv->version_state != GestureVersionKnown) {
+	/* a failure is not cached, the next call asks again */
+	GetReq(GestureQueryVersion, req);
+	req->reqType = info->codes->major_opcode;
+	req->gestureReqType = X_GestureQueryVersion;
+	if (!_XReply(dpy, (xReply *)&rep, 0, xFalse)) {
+	    priv->version_state = GestureVersionFailed;
+	} else {
+	    version_known(priv, rep.majorVersion, rep.minorVersion,
+			  rep.patchVersion);
+	}
+    }
+
+    if (priv->version_state != GestureVersionKnown) {
         UnlockDisplay(dpy);
         SyncHandle();
         TRACE("QueryVersion... return False");
         return False;
     }
-    *majorVersion = rep.majorVersion;
-    *minorVersion = rep.minorVersion;
-    *patchVersion = rep.patchVersion;
+    *majorVersion = priv->major_version;
+    *minorVersion = priv->minor_version;
+    *patchVersion = priv->patch_version;
     UnlockDisplay(dpy);
     SyncHandle();
     TRACE("QueryVersion... return True");
@@ -707,11 +935,17 @@ Status XGestureSelectEvents(Display* dpy, Window w, Mask mask)
     GestureCheckExtension (dpy, info, False);
 
     LockDisplay(dpy);
+    if (_XGestureSelectIsRedundant(dpy, GesturePriv(info), w, mask)) {
+	UnlockDisplay(dpy);
+	TRACE("SelectEvents... unchanged, not sent");
+	return GestureSuccess;
+    }
     GetReq(GestureSelectEvents, req);
     req->reqType = info->codes->major_opcode;
     req->gestureReqType = X_GestureSelectEvents;
     req->window = w;
     req->mask = mask;
+    _XGestureRecordSelect(GesturePriv(info), w, mask, dpy->request);
     UnlockDisplay(dpy);
     SyncHandle();
     TRACE("SelectEvents... return True");
@@ -745,6 +979,7 @@ Status XGestureGetSelectedEvents(Display* dpy, Window w, Mask *mask_return)
     }
 
     mask_out = rep.mask;
+    _XGestureRecordSelect(GesturePriv(info), w, mask_out, dpy->request);
 
     UnlockDisplay(dpy);
     SyncHandle();
@@ -755,6 +990,24 @@ Status XGestureGetSelectedEvents(Display* dpy, Window w, Mask *mask_return)
     return GestureSuccess;
 }
 
+/*
+ * Reject what the server would refuse before anything is queued, so an
+ * invalid call costs neither the display lock nor a round-trip.  A grab
+ * needs at least one finger: no gesture event reports fewer.
+ */
+static Bool
+valid_grab_args(Window w, int eventType, int num_finger)
+{
+    if (w == None)
+	return False;
+    if (eventType < 0 || eventType >= GestureNumberEvents)
+	return False;
+    if (num_finger < 1 || num_finger > GESTURE_MAX_NUM_FINGER)
+	return False;
+
+    return True;
+}
+
 Status XGestureGrabEvent(Display* dpy, Window w, int eventType, int num_finger, Time time)
 {
     XExtDisplayInfo *info = find_display (dpy);
@@ -765,7 +1018,18 @@ Status XGestureGrabEvent(Display* dpy, Window w, int eventType, int num_finger,
     TRACE("GrabEvent...");
     GestureCheckExtension (dpy, info, False);
 
+    if( !valid_grab_args(w, eventType, num_finger) )
+    {
+    	TRACE("GrabEvent... return GestureGrabAbnormal");
+	return GestureGrabAbnormal;
+    }
+
     LockDisplay(dpy);
+    if (_XGestureGrabIsActive(GesturePriv(info), w, eventType, num_finger)) {
+	UnlockDisplay(dpy);
+	TRACE("GrabEvent... already grabbed, not sent");
+	return GestureSuccess;
+    }
     GetReq(GestureGrabEvent, req);
     req->reqType = info->codes->major_opcode;
     req->gestureReqType = X_GestureGrabEvent;
@@ -774,12 +1038,6 @@ Status XGestureGrabEvent(Display* dpy, Window w, int eventType, int num_finger,
     req->num_finger = num_finger;
     req->time = time;
 
-    if( eventType >= GestureNumberEvents )
-    {
-    	TRACE("GrabEvent... return GestureGrabAbnormal");
-	return GestureGrabAbnormal;
-    }
-
     /* if we ever return, suppress the error */
     if ( !_XReply (dpy, (xReply *) &rep, 0, xTrue) )
     {
@@ -790,6 +1048,8 @@ Status XGestureGrabEvent(Display* dpy, Window w, int eventType, int num_finger,
     }
 
     status = rep.status;
+    if (status == GestureSuccess)
+	_XGestureRecordGrab(GesturePriv(info), w, eventType, num_finger, True);
 
     UnlockDisplay(dpy);
     SyncHandle();
@@ -808,9 +1068,9 @@ Status XGestureUngrabEvent(Display* dpy, Window w, int eventType, int num_finger
     TRACE("UnrabEvent...");
     GestureCheckExtension (dpy, info, False);
 
-    if( !w )
+    if( !valid_grab_args(w, eventType, num_finger) )
     {
-    	TRACE("UnrabEvent...w is invalid");
+    	TRACE("UnrabEvent... return GestureUngrabAbnormal");
 	return GestureUngrabAbnormal;
     }
 
@@ -823,12 +1083,6 @@ Status XGestureUngrabEvent(Display* dpy, Window w, int eventType, int num_finger
     req->num_finger = num_finger;
     req->time = time;
 
-    if( eventType >= GestureNumberEvents )
-    {
-    	TRACE("UnrabEvent... return GestureUngrabAbnormal");
-	return GestureUngrabAbnormal;
-    }
-
     /* if we ever return, suppress the error */
     if ( !_XReply (dpy, (xReply *) &rep, 0, xTrue) )
     {
@@ -839,6 +1093,8 @@ Status XGestureUngrabEvent(Display* dpy, Window w, int eventType, int num_finger
     }
 
     status = rep.status;
+    if (status == GestureSuccess)
+	_XGestureRecordGrab(GesturePriv(info), w, eventType, num_finger, False);
 
     UnlockDisplay(dpy);
     SyncHandle();
@@ -847,3 +1103,69 @@ Status XGestureUngrabEvent(Display* dpy, Window w, int eventType, int num_finger
     return status;
 }
 
+
+Status XGestureSendEvents(Display* dpy, Bool propagate, long event_mask,
+			  XGestureCommonEvent *events, int num_events)
+{
+    XExtDisplayInfo *info = find_display (dpy);
+    xSendEventReq *req;
+    xEvent ev;
+    int type;
+    int i;
+
+    TRACE("SendEvents...");
+    GestureCheckExtension (dpy, info, False);
+
+    if( num_events < 0 || (num_events && !events) )
+    {
+	TRACE("SendEvents... invalid arguments");
+	return GestureInvalidReply;
+    }
+
+    /* reject the whole batch up front rather than sending part of it */
+    for (i = 0; i < num_events; i++)
+    {
+	type = events[i].any.type - info->codes->first_event;
+	if( type < 0 || type >= GestureNumberEvents || !events[i].any.window )
+	{
+	    TRACE("SendEvents... invalid event in batch");
+	    return GestureInvalidReply;
+	}
+    }
+
+    LockDisplay(dpy);
+    for (i = 0; i < num_events; i++)
+    {
+	memset(&ev, 0, sizeof(ev));
+	if (!gesture_event_to_wire(info, (XEvent *)&events[i], &ev))
+	    continue;
+
+	GetReq(SendEvent, req);
+	req->destination = events[i].any.window;
+	req->propagate = propagate;
+	req->eventMask = event_mask;
+	req->event = ev;
+    }
+    UnlockDisplay(dpy);
+    SyncHandle();
+
+    /* the whole batch goes out in one write */
+    XFlush(dpy);
+    TRACE("SendEvents... return success");
+
+    return GestureSuccess;
+}
+
+Bool XGestureSetEventLog(Display* dpy, XGestureEventLog *log)
+{
+    XExtDisplayInfo *info = find_display (dpy);
+
+    TRACE("SetEventLog...");
+    GestureCheckExtension (dpy, info, False);
+
+    LockDisplay(dpy);
+    GesturePriv(info)->event_log = log;
+    UnlockDisplay(dpy);
+
+    return True;
+}
@@ -0,0 +1,226 @@
+/*
+ *
+ * libxgesture
+ *
+ * Contact: Sung-Jin Park <sj76.park@samsung.com>
+ *          Sangjin LEE <lsj119@samsung.com>
+ *
+ * Copyright (c) 2011 Samsung Electronics Co., Ltd All Rights Reserved 
+ *
+ * Permission to use, copy, modify, distribute, and sell this software
+ * and its documentation for any purpose is hereby granted without
+ * fee, provided that the above copyright notice appear in all copies
+ * and that both that copyright notice and this permission notice
+ * appear in supporting documentation, and that the name of Red Hat
+ * not be used in advertising or publicity pertaining to distribution
+ * of the software without specific, written prior permission.  Red
+ * Hat makes no representations about the suitability of this software
+ * for any purpose.  It is provided "as is" without express or implied
+ * warranty.
+ *
+ * THE AUTHORS DISCLAIM ALL WARRANTIES WITH REGARD TO THIS SOFTWARE,
+ * INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS, IN
+ * NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY SPECIAL, INDIRECT OR
+ * CONSEQUENTIAL DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS
+ * OF USE, DATA OR PROFITS, WHETHER IN AN ACTION OF CONTRACT,
+ * NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN
+ * CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ *
+ */
+
+#ifndef _GESTURE_INT_H_
+#define _GESTURE_INT_H_
+
+#include <stdio.h>
+#ifdef __XGESTURE_LIB_DEBUG__
+#define TRACE(msg)  fprintf(stderr, "[X11][GestureExt] %s\n", msg);
+#else
+#define TRACE(msg)
+#endif
+
+#define GestureCheckExtension(dpy,i,val) \
+  XextCheckExtension (dpy, i, GESTURE_EXT_NAME, val)
+#define GestureSimpleCheckExtension(dpy,i) \
+  XextSimpleCheckExtension (dpy, i, GESTURE_EXT_NAME)
+
+/*
+ * Library private per-display state, kept in XExtDisplayInfo::data.
+ * All fields are protected by the display lock.
+ */
+
+#define GestureVersionUnknown	0
+#define GestureVersionPending	1
+#define GestureVersionKnown	2
+#define GestureVersionFailed	3
+
+/*
+ * Upper bound for num_finger in grab and ungrab requests, checked locally.
+ * The protocol has no request that reports the server's limit, so this is
+ * a fixed library limit, documented with XGestureGrabEvent() in gesture.h.
+ */
+#define GESTURE_MAX_NUM_FINGER	10
+
+typedef struct _GestureHistoryRec *GestureHistoryPtr;
+typedef struct _GestureRegionsRec *GestureRegionsPtr;
+typedef struct _GesturePriorityRec *GesturePriorityPtr;
+typedef struct _GestureTelemetryRec *GestureTelemetryPtr;
+typedef struct _GestureFilterRec *GestureFilterPtr;
+
+/* per-window library state, see window.c */
+typedef struct _GestureWindowRec {
+    struct _GestureWindowRec *next;
+    Window window;
+    GestureHistoryPtr history;
+
+    /* geometry cache, see geometry.c */
+    Bool track_geometry;
+    Bool geometry_valid;
+    Window root;
+    Window parent;
+    int root_x;			/* origin inside the border, root relative */
+    int root_y;
+    int border_width;
+
+    /* hit-test regions, see region.c */
+    GestureRegionsPtr regions;
+    unsigned long last_target;
+
+    /* request coalescing, see coalesce.c */
+    Bool mask_known;
+    Mask selected_mask;
+    unsigned long select_seq;	/* request that selected it */
+    unsigned int grabbed[GestureNumberEvents];	/* bit per num_finger */
+
+    /* finger group the window's gestures belong to, see group.c */
+    Bool has_group;
+    int current_group;
+
+    /* smoothing per event type, see filter.c */
+    GestureFilterPtr filters[GestureNumberEvents];
+} GestureWindowRec, *GestureWindowPtr;
+
+#define GESTURE_WINDOW_HASH_SIZE	64
+#define GESTURE_MAX_HOOKED_ERRORS	(5 + GestureNumberErrors)
+#define GESTURE_GROUP_TABLE_SIZE	64
+#define GestureWindowHash(w)	((unsigned int)(w) & (GESTURE_WINDOW_HASH_SIZE - 1))
+
+typedef struct _GestureDisplayPrivRec {
+    /* cached result of the QueryVersion negotiation */
+    int version_state;
+    int major_version;
+    int minor_version;
+    int patch_version;
+    int num_errors;		/* 0 until the version is known */
+
+    /* outstanding XGesturePrefetchVersion() request */
+    unsigned long version_seq;
+    _XAsyncHandler version_async;
+
+    /* columnar log filled straight from the wire, see eventlog.c */
+    XGestureEventLog *event_log;
+
+    GestureWindowPtr windows[GESTURE_WINDOW_HASH_SIZE];
+
+    /* XGestureGetEventFd() wakeup descriptor, read and write end */
+    int notify_fd[2];
+    Bool notify_pending;
+
+    Bool coalesce_requests;
+
+    /* finger groups indexed by groupid */
+    XGestureGroupInfo groups[GESTURE_GROUP_TABLE_SIZE];
+
+    /* priority dispatch ring, non-NULL while enabled, see priority.c */
+    GesturePriorityPtr priority;
+
+    /* mapped telemetry ring file, see telemetry.c */
+    GestureTelemetryPtr telemetry;
+
+    /* chained core decoders, non-NULL once hooked, see window.c */
+    Bool (*core_wire_to_event[LASTEvent])(Display *, XEvent *, xEvent *);
+
+    /* chained error converters, see coalesce.c */
+    int num_hooked_errors;
+    int hooked_error_code[GESTURE_MAX_HOOKED_ERRORS];
+    Bool (*wire_to_error[GESTURE_MAX_HOOKED_ERRORS])(Display *, XErrorEvent *,
+						     xError *);
+} GestureDisplayPrivRec, *GestureDisplayPrivPtr;
+
+#define GesturePriv(info) ((GestureDisplayPrivPtr)(info)->data)
+
+/* gesture.c */
+extern XExtDisplayInfo *_XGestureFindDisplay(Display *dpy);
+
+/* window.c */
+extern GestureWindowPtr _XGestureFindWindow(GestureDisplayPrivPtr priv,
+					    Window w, Bool create);
+extern void _XGesturePruneWindow(GestureDisplayPrivPtr priv,
+				 GestureWindowPtr win);
+extern void _XGestureFreeWindows(GestureDisplayPrivPtr priv);
+extern void _XGestureHookCoreEvents(Display *dpy, GestureDisplayPrivPtr priv);
+
+/* geometry.c */
+extern void _XGestureGeometryCoreEvent(GestureDisplayPrivPtr priv,
+				       XEvent *event);
+extern void _XGestureGeometryTranslate(GestureWindowPtr win, int type,
+				       XEvent *event);
+
+/* history.c */
+extern GestureHistoryPtr _XGestureHistoryCreate(int capacity);
+extern void _XGestureHistoryAdd(GestureHistoryPtr history, int type,
+				XEvent *event);
+extern void _XGestureHistoryFree(GestureHistoryPtr history);
+extern void _XGestureHistoryStats(GestureHistoryPtr history, Time start,
+				  Time end, XGestureHistoryStats *stats);
+
+/* region.c */
+extern void _XGestureRegionsResolve(GestureWindowPtr win, int type,
+				    XEvent *event);
+extern void _XGestureRegionsFree(GestureRegionsPtr regions);
+extern Bool _XGestureRegionsAdd(GestureRegionsPtr *regions, unsigned long id,
+				int x, int y, unsigned int width,
+				unsigned int height);
+
+/* coalesce.c */
+extern Bool _XGestureSelectIsRedundant(Display *dpy, GestureDisplayPrivPtr priv,
+				       Window w, Mask mask);
+extern void _XGestureRecordSelect(GestureDisplayPrivPtr priv, Window w,
+				  Mask mask, unsigned long seq);
+extern Bool _XGestureGrabIsActive(GestureDisplayPrivPtr priv, Window w,
+				  int eventType, int num_finger);
+extern void _XGestureRecordGrab(GestureDisplayPrivPtr priv, Window w,
+				int eventType, int num_finger, Bool grabbed);
+extern void _XGestureForgetGrabs(GestureDisplayPrivPtr priv, Window w);
+
+/* group.c */
+extern void _XGestureGroupUpdate(GestureDisplayPrivPtr priv, XEvent *event);
+extern void _XGestureGroupStamp(GestureWindowPtr win, int type,
+				XEvent *event);
+
+/* priority.c */
+extern Bool _XGesturePriorityEnqueue(Display *dpy, GesturePriorityPtr queue,
+				     XEvent *event);
+extern void _XGesturePriorityFree(GesturePriorityPtr queue);
+
+/* telemetry.c */
+extern void _XGestureTelemetryRecord(GestureTelemetryPtr t, int type,
+				     XEvent *event);
+extern void _XGestureTelemetryClose(GestureTelemetryPtr t);
+
+/* filter.c */
+extern GestureFilterPtr _XGestureFilterCreate(double min_cutoff, double beta,
+					      double d_cutoff);
+extern void _XGestureFilterApply(GestureWindowPtr win, int type,
+				 XEvent *event);
+extern void _XGestureFilterFree(GestureFilterPtr filter);
+
+/* notify.c */
+extern void _XGestureNotifyInit(GestureDisplayPrivPtr priv);
+extern void _XGestureNotifyClose(GestureDisplayPrivPtr priv);
+extern void _XGestureNotifyEvent(GestureDisplayPrivPtr priv);
+
+/* eventlog.c */
+extern Bool _XGestureEventLogAppendWire(XGestureEventLog *log, int type,
+					xEvent *wire);
+
+#endif//_GESTURE_INT_H_
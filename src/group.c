@@ -0,0 +1,139 @@
+/*
+ *
+ * libxgesture
+ *
+ * Contact: Sung-Jin Park <sj76.park@samsung.com>
+ *          Sangjin LEE <lsj119@samsung.com>
+ *
+ * Copyright (c) 2011 Samsung Electronics Co., Ltd All Rights Reserved 
+ *
+ * Permission to use, copy, modify, distribute, and sell this software
+ * and its documentation for any purpose is hereby granted without
+ * fee, provided that the above copyright notice appear in all copies
+ * and that both that copyright notice and this permission notice
+ * appear in supporting documentation, and that the name of Red Hat
+ * not be used in advertising or publicity pertaining to distribution
+ * of the software without specific, written prior permission.  Red
+ * Hat makes no representations about the suitability of this software
+ * for any purpose.  It is provided "as is" without express or implied
+ * warranty.
+ *
+ * THE AUTHORS DISCLAIM ALL WARRANTIES WITH REGARD TO THIS SOFTWARE,
+ * INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS, IN
+ * NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY SPECIAL, INDIRECT OR
+ * CONSEQUENTIAL DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS
+ * OF USE, DATA OR PROFITS, WHETHER IN AN ACTION OF CONTRACT,
+ * NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN
+ * CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ *
+ */
+
+/*
+ * Finger group tracking.
+ *
+ * GestureNotifyGroup events maintain a small direct-mapped table indexed by
+ * groupid, so membership and lifetime lookups are O(1).  Each window also
+ * remembers its current group, which the decoder stamps into every other
+ * gesture event delivered to that window.
+ */
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+#include <X11/Xlibint.h>
+#include <X11/extensions/Xext.h>
+#include <X11/extensions/extutil.h>
+#include <X11/extensions/gesture.h>
+#include "gestureint.h"
+
+#define GroupSlot(priv, id) \
+    (&(priv)->groups[(unsigned int)(id) & (GESTURE_GROUP_TABLE_SIZE - 1)])
+
+void
+_XGestureGroupUpdate(GestureDisplayPrivPtr priv, XEvent *event)
+{
+    XGestureNotifyGroupEvent *gev = (XGestureNotifyGroupEvent *)event;
+    XGestureGroupInfo *group = GroupSlot(priv, gev->groupid);
+    GestureWindowPtr win;
+
+    switch (gev->kind) {
+	case GestureGroupAdded:
+	case GestureGroupCurrent:
+	    if (!group->active || group->groupid != gev->groupid) {
+		/* a new group, possibly recycling the slot of an old one */
+		group->groupid = gev->groupid;
+		group->window = gev->window;
+		group->start_time = gev->time;
+		group->end_time = 0;
+		group->active = True;
+	    }
+	    group->num_group = gev->num_group;
+
+	    if ((win = _XGestureFindWindow(priv, gev->window, True))) {
+		win->has_group = True;
+		win->current_group = gev->groupid;
+	    }
+	    break;
+
+	case GestureGroupRemoved:
+	    if (group->groupid == gev->groupid) {
+		group->num_group = gev->num_group;
+		group->end_time = gev->time;
+		group->active = False;
+	    }
+
+	    win = _XGestureFindWindow(priv, gev->window, False);
+	    if (win && win->has_group && win->current_group == gev->groupid) {
+		win->has_group = False;
+		_XGesturePruneWindow(priv, win);
+	    }
+	    break;
+    }
+}
+
+void
+_XGestureGroupStamp(GestureWindowPtr win, int type, XEvent *event)
+{
+    XGestureCommonEvent *ev = (XGestureCommonEvent *)event;
+    int groupid = (win && win->has_group) ? win->current_group : -1;
+
+    switch (type) {
+	case GestureNotifyFlick:
+	    ev->fev.groupid = groupid;
+	    break;
+	case GestureNotifyPan:
+	    ev->pev.groupid = groupid;
+	    break;
+	case GestureNotifyPinchRotation:
+	    ev->pcrev.groupid = groupid;
+	    break;
+	case GestureNotifyTap:
+	    ev->tev.groupid = groupid;
+	    break;
+	case GestureNotifyTapNHold:
+	    ev->thev.groupid = groupid;
+	    break;
+	case GestureNotifyHold:
+	    ev->hev.groupid = groupid;
+	    break;
+    }
+}
+
+Bool
+XGestureGetGroupInfo(Display* dpy, int groupid, XGestureGroupInfo *info_return)
+{
+    XExtDisplayInfo *info = _XGestureFindDisplay (dpy);
+    XGestureGroupInfo *group;
+    Bool found;
+
+    GestureCheckExtension (dpy, info, False);
+
+    LockDisplay(dpy);
+    group = GroupSlot(GesturePriv(info), groupid);
+    found = group->window && group->groupid == groupid;
+    if (found)
+	*info_return = *group;
+    UnlockDisplay(dpy);
+
+    return found;
+}
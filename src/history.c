@@ -0,0 +1,279 @@
+/*
+ *
+ * libxgesture
+ *
+ * Contact: Sung-Jin Park <sj76.park@samsung.com>
+ *          Sangjin LEE <lsj119@samsung.com>
+ *
+ * Copyright (c) 2011 Samsung Electronics Co., Ltd All Rights Reserved 
+ *
+ * Permission to use, copy, modify, distribute, and sell this software
+ * and its documentation for any purpose is hereby granted without
+ * fee, provided that the above copyright notice appear in all copies
+ * and that both that copyright notice and this permission notice
+ * appear in supporting documentation, and that the name of Red Hat
+ * not be used in advertising or publicity pertaining to distribution
+ * of the software without specific, written prior permission.  Red
+ * Hat makes no representations about the suitability of this software
+ * for any purpose.  It is provided "as is" without express or implied
+ * warranty.
+ *
+ * THE AUTHORS DISCLAIM ALL WARRANTIES WITH REGARD TO THIS SOFTWARE,
+ * INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS, IN
+ * NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY SPECIAL, INDIRECT OR
+ * CONSEQUENTIAL DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS
+ * OF USE, DATA OR PROFITS, WHETHER IN AN ACTION OF CONTRACT,
+ * NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN
+ * CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ *
+ */
+
+/*
+ * Bounded per-window gesture history.
+ *
+ * Events are kept in a ring ordered by server time.  Every entry carries
+ * running totals of the aggregated values, so any time range is answered
+ * with two binary searches and one subtraction instead of a walk over the
+ * stored events.
+ */
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+#include <X11/Xlibint.h>
+#include <X11/extensions/Xext.h>
+#include <X11/extensions/extutil.h>
+#include <X11/extensions/gesture.h>
+#include "gestureint.h"
+
+typedef struct {
+    Time time;
+    int type;
+    int dx;
+    int dy;
+    XFixed zoom;
+
+    /* totals up to and including this entry */
+    long long cum_dx;
+    long long cum_dy;
+    long long cum_zoom;
+    unsigned int cum_pan;
+    unsigned int cum_pinch;
+    unsigned int cum_tap;
+} HistoryEntry;
+
+typedef struct _GestureHistoryRec {
+    int capacity;
+    int start;		/* oldest entry */
+    int count;
+    HistoryEntry entries[1];
+} GestureHistoryRec;
+
+#define ENTRY(h, i)	(&(h)->entries[((h)->start + (i)) % (h)->capacity])
+
+GestureHistoryPtr
+_XGestureHistoryCreate(int capacity)
+{
+    GestureHistoryPtr history;
+
+    history = Xcalloc(1, sizeof(GestureHistoryRec) +
+		      (capacity - 1) * sizeof(HistoryEntry));
+    if (history)
+	history->capacity = capacity;
+
+    return history;
+}
+
+void
+_XGestureHistoryFree(GestureHistoryPtr history)
+{
+    Xfree(history);
+}
+
+void
+_XGestureHistoryAdd(GestureHistoryPtr history, int type, XEvent *event)
+{
+    XGestureCommonEvent *ev = (XGestureCommonEvent *)event;
+    HistoryEntry *prev = NULL;
+    HistoryEntry *e;
+    Time time = ev->any.time;
+
+    if (type == GestureNotifyGroup)
+	return;
+
+    if (history->count) {
+	prev = ENTRY(history, history->count - 1);
+	/* keep the ring sorted even if the server clock steps back */
+	if ((INT32)(time - prev->time) < 0)
+	    time = prev->time;
+    }
+
+    if (history->count == history->capacity) {
+	history->start = (history->start + 1) % history->capacity;
+	history->count--;
+    }
+    e = ENTRY(history, history->count);
+    history->count++;
+
+    e->time = time;
+    e->type = type;
+    e->dx = e->dy = 0;
+    e->zoom = 0;
+    if (type == GestureNotifyPan) {
+	e->dx = ev->pev.dx;
+	e->dy = ev->pev.dy;
+    } else if (type == GestureNotifyPinchRotation) {
+	e->zoom = ev->pcrev.zoom;
+    }
+
+    e->cum_dx = (prev ? prev->cum_dx : 0) + e->dx;
+    e->cum_dy = (prev ? prev->cum_dy : 0) + e->dy;
+    e->cum_zoom = (prev ? prev->cum_zoom : 0) + e->zoom;
+    e->cum_pan = (prev ? prev->cum_pan : 0) + (type == GestureNotifyPan);
+    e->cum_pinch = (prev ? prev->cum_pinch : 0) +
+	(type == GestureNotifyPinchRotation);
+    e->cum_tap = (prev ? prev->cum_tap : 0) + (type == GestureNotifyTap);
+}
+
+/* first entry whose time offset from the oldest entry is >= off */
+static int
+lower_bound(GestureHistoryPtr history, Time base, CARD32 off)
+{
+    int lo = 0, hi = history->count, mid;
+
+    /* Time is wider than the 32 bit server clock on LP64 */
+    while (lo < hi) {
+	mid = lo + (hi - lo) / 2;
+	if ((CARD32)(ENTRY(history, mid)->time - base) < off)
+	    lo = mid + 1;
+	else
+	    hi = mid;
+    }
+
+    return lo;
+}
+
+void
+_XGestureHistoryStats(GestureHistoryPtr history, Time start, Time end,
+		      XGestureHistoryStats *stats)
+{
+    HistoryEntry *first, *last;
+    Time base;
+    INT32 start_off, end_off;
+    int lo, hi;
+
+    memset(stats, 0, sizeof(XGestureHistoryStats));
+    if (!history->count)
+	return;
+
+    /* compare relative to the oldest entry so that time wraparound is harmless */
+    base = ENTRY(history, 0)->time;
+    start_off = (INT32)(start - base);
+    end_off = (INT32)(end - base);
+    if (end_off < 0 || end_off < start_off)
+	return;
+    if (start_off < 0)
+	start_off = 0;
+
+    lo = lower_bound(history, base, start_off);
+    hi = lower_bound(history, base, (CARD32)end_off + 1) - 1;
+    if (lo > hi)
+	return;
+
+    first = ENTRY(history, lo);
+    last = ENTRY(history, hi);
+
+    stats->num_events = hi - lo + 1;
+    stats->first_time = first->time;
+    stats->last_time = last->time;
+    stats->num_pan = last->cum_pan - first->cum_pan +
+	(first->type == GestureNotifyPan);
+    stats->num_pinch = last->cum_pinch - first->cum_pinch +
+	(first->type == GestureNotifyPinchRotation);
+    stats->num_tap = last->cum_tap - first->cum_tap +
+	(first->type == GestureNotifyTap);
+    stats->sum_dx = last->cum_dx - first->cum_dx + first->dx;
+    stats->sum_dy = last->cum_dy - first->cum_dy + first->dy;
+    if (stats->num_pinch)
+	stats->mean_zoom = (XFixed)((last->cum_zoom - first->cum_zoom +
+				     first->zoom) / stats->num_pinch);
+}
+
+Bool
+XGestureEnableHistory(Display* dpy, Window w, int capacity)
+{
+    XExtDisplayInfo *info = _XGestureFindDisplay (dpy);
+    GestureDisplayPrivPtr priv;
+    GestureWindowPtr win;
+    GestureHistoryPtr history = NULL;
+
+    TRACE("EnableHistory...");
+    GestureCheckExtension (dpy, info, False);
+    priv = GesturePriv(info);
+
+    if (capacity > 0 && !(history = _XGestureHistoryCreate(capacity)))
+	return False;
+
+    LockDisplay(dpy);
+    win = _XGestureFindWindow(priv, w, capacity > 0);
+    if (!win) {
+	UnlockDisplay(dpy);
+	_XGestureHistoryFree(history);
+	return capacity <= 0;
+    }
+    _XGestureHistoryFree(win->history);
+    win->history = history;
+    _XGesturePruneWindow(priv, win);
+    UnlockDisplay(dpy);
+
+    return True;
+}
+
+Bool
+XGestureQueryHistory(Display* dpy, Window w, Time start, Time end,
+		     XGestureHistoryStats *stats)
+{
+    XExtDisplayInfo *info = _XGestureFindDisplay (dpy);
+    GestureWindowPtr win;
+
+    GestureCheckExtension (dpy, info, False);
+
+    LockDisplay(dpy);
+    win = _XGestureFindWindow(GesturePriv(info), w, False);
+    if (!win || !win->history) {
+	UnlockDisplay(dpy);
+	return False;
+    }
+    _XGestureHistoryStats(win->history, start, end, stats);
+    UnlockDisplay(dpy);
+
+    return True;
+}
+
+Bool
+XGestureQueryRecentHistory(Display* dpy, Window w, Time interval,
+			   XGestureHistoryStats *stats)
+{
+    XExtDisplayInfo *info = _XGestureFindDisplay (dpy);
+    GestureWindowPtr win;
+    GestureHistoryPtr history;
+    Time newest;
+
+    GestureCheckExtension (dpy, info, False);
+
+    LockDisplay(dpy);
+    win = _XGestureFindWindow(GesturePriv(info), w, False);
+    if (!win || !(history = win->history)) {
+	UnlockDisplay(dpy);
+	return False;
+    }
+    if (!history->count) {
+	memset(stats, 0, sizeof(XGestureHistoryStats));
+    } else {
+	newest = ENTRY(history, history->count - 1)->time;
+	_XGestureHistoryStats(history, newest - interval, newest, stats);
+    }
+    UnlockDisplay(dpy);
+
+    return True;
+}
@@ -0,0 +1,220 @@
+/*
+ *
+ * libxgesture
+ *
+ * Contact: Sung-Jin Park <sj76.park@samsung.com>
+ *          Sangjin LEE <lsj119@samsung.com>
+ *
+ * Copyright (c) 2011 Samsung Electronics Co., Ltd All Rights Reserved 
+ *
+ * Permission to use, copy, modify, distribute, and sell this software
+ * and its documentation for any purpose is hereby granted without
+ * fee, provided that the above copyright notice appear in all copies
+ * and that both that copyright notice and this permission notice
+ * appear in supporting documentation, and that the name of Red Hat
+ * not be used in advertising or publicity pertaining to distribution
+ * of the software without specific, written prior permission.  Red
+ * Hat makes no representations about the suitability of this software
+ * for any purpose.  It is provided "as is" without express or implied
+ * warranty.
+ *
+ * THE AUTHORS DISCLAIM ALL WARRANTIES WITH REGARD TO THIS SOFTWARE,
+ * INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS, IN
+ * NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY SPECIAL, INDIRECT OR
+ * CONSEQUENTIAL DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS
+ * OF USE, DATA OR PROFITS, WHETHER IN AN ACTION OF CONTRACT,
+ * NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN
+ * CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ *
+ */
+
+/*
+ * Kinetic scrolling driven by Flick and Pan events.
+ *
+ * A fling decays exponentially, so its offset at time t after release is
+ *
+ *	offset(t) = v0 * tau * (1 - exp(-t / tau))
+ *
+ * The bracketed term is precomputed once as a 16.16 fixed point table;
+ * evaluating a frame is a table lookup, an interpolation and two integer
+ * multiplies.
+ */
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+#include <X11/Xlibint.h>
+#include <X11/extensions/gesture.h>
+#include <X11/extensions/gestureconst.h>
+
+#include <math.h>
+
+#define KINETIC_TAU		325	/* deceleration time constant (ms) */
+#define KINETIC_STEP_SHIFT	3	/* table step of 8 ms */
+#define KINETIC_TABLE_SIZE	256	/* covers about 6 tau */
+#define KINETIC_MIN_VELOCITY	(XDoubleToFixed(0.05))	/* px/ms */
+#define KINETIC_MAX_IDLE	80	/* no fling if the finger rested longer (ms) */
+
+struct _XGestureKineticScroller {
+    /* pan tracking */
+    Time last_time;
+    Time last_motion;		/* last sample that moved */
+    XFixed vx;			/* px/ms */
+    XFixed vy;
+
+    /* current fling */
+    Bool active;
+    Time start_time;
+    long long amplitude_x;	/* v0 * tau, 16.16 px */
+    long long amplitude_y;
+
+    /* where the last fling came to rest */
+    int rest_x;
+    int rest_y;
+};
+
+static XFixed decel_table[KINETIC_TABLE_SIZE];
+static Bool decel_table_ready;
+
+static void
+init_decel_table(void)
+{
+    int i;
+
+    /* every caller writes identical values, so a racing init is harmless */
+    for (i = 0; i < KINETIC_TABLE_SIZE; i++)
+	decel_table[i] = XDoubleToFixed(1.0 -
+	    exp(-(double)(i << KINETIC_STEP_SHIFT) / KINETIC_TAU));
+    decel_table_ready = True;
+}
+
+XGestureKineticScroller *
+XGestureKineticCreate(void)
+{
+    if (!decel_table_ready)
+	init_decel_table();
+
+    return Xcalloc(1, sizeof(XGestureKineticScroller));
+}
+
+void
+XGestureKineticDestroy(XGestureKineticScroller *ks)
+{
+    Xfree(ks);
+}
+
+void
+XGestureKineticStop(XGestureKineticScroller *ks)
+{
+    ks->active = False;
+    ks->rest_x = ks->rest_y = 0;
+}
+
+static Bool
+start_fling(XGestureKineticScroller *ks, Time time, XFixed vx, XFixed vy)
+{
+    ks->rest_x = ks->rest_y = 0;
+    if (abs(vx) < KINETIC_MIN_VELOCITY && abs(vy) < KINETIC_MIN_VELOCITY) {
+	ks->active = False;
+	return False;
+    }
+
+    ks->active = True;
+    ks->start_time = time;
+    ks->amplitude_x = (long long)vx * KINETIC_TAU;
+    ks->amplitude_y = (long long)vy * KINETIC_TAU;
+
+    return True;
+}
+
+Bool
+XGestureKineticFeed(XGestureKineticScroller *ks, int event_base,
+		    XGestureCommonEvent *ev)
+{
+    XGestureNotifyFlickEvent *fev;
+    XGestureNotifyPanEvent *pev;
+    Time elapsed;
+    double speed, angle;
+
+    switch (ev->any.type - event_base) {
+	case GestureNotifyPan:
+	    pev = &ev->pev;
+	    if (pev->kind == GestureBegin) {
+		ks->active = False;
+		ks->rest_x = ks->rest_y = 0;
+		ks->vx = ks->vy = 0;
+		ks->last_time = ks->last_motion = pev->time;
+		return False;
+	    }
+
+	    /* a finger that rested has no velocity left to carry on */
+	    if ((CARD32)(pev->time - ks->last_motion) > KINETIC_MAX_IDLE)
+		ks->vx = ks->vy = 0;
+
+	    /* weight the latest sample 3:1 against the running estimate */
+	    elapsed = (CARD32)(pev->time - ks->last_time);
+	    if (pev->dx || pev->dy) {
+		if (elapsed > 0 && elapsed < 0x80000000) {
+		    ks->vx = (3 * ((pev->dx * 65536) / (int)elapsed) + ks->vx) / 4;
+		    ks->vy = (3 * ((pev->dy * 65536) / (int)elapsed) + ks->vy) / 4;
+		}
+		ks->last_motion = pev->time;
+	    }
+	    ks->last_time = pev->time;
+
+	    if (pev->kind == GestureEnd)
+		return start_fling(ks, pev->time, ks->vx, ks->vy);
+	    return False;
+
+	case GestureNotifyFlick:
+	    fev = &ev->fev;
+	    if (fev->kind != GestureEnd || !fev->duration)
+		return False;
+
+	    /* angle is measured from the horizontal, counterclockwise with y up */
+	    speed = (double)fev->distance / fev->duration;
+	    angle = XFixedToDouble(fev->angle);
+	    return start_fling(ks, fev->time,
+			       XDoubleToFixed(speed * cos(angle)),
+			       XDoubleToFixed(-speed * sin(angle)));
+    }
+
+    return False;
+}
+
+Bool
+XGestureKineticGetOffset(XGestureKineticScroller *ks, Time time,
+			 int *x_return, int *y_return)
+{
+    Time t = time - ks->start_time;
+    unsigned int i, frac;
+    long long f;
+
+    if (!ks->active) {
+	*x_return = ks->rest_x;
+	*y_return = ks->rest_y;
+	return False;
+    }
+
+    if ((INT32)t < 0)
+	t = 0;
+
+    i = t >> KINETIC_STEP_SHIFT;
+    if (i >= KINETIC_TABLE_SIZE - 1) {
+	f = decel_table[KINETIC_TABLE_SIZE - 1];
+	ks->active = False;
+    } else {
+	frac = t & ((1 << KINETIC_STEP_SHIFT) - 1);
+	f = decel_table[i] + (((long long)(decel_table[i + 1] - decel_table[i]) *
+			      frac) >> KINETIC_STEP_SHIFT);
+    }
+
+    *x_return = (int)((ks->amplitude_x * f) >> 32);
+    *y_return = (int)((ks->amplitude_y * f) >> 32);
+    if (!ks->active) {
+	ks->rest_x = *x_return;
+	ks->rest_y = *y_return;
+    }
+
+    return True;
+}
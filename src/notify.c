@@ -0,0 +1,164 @@
+/*
+ *
+ * libxgesture
+ *
+ * Contact: Sung-Jin Park <sj76.park@samsung.com>
+ *          Sangjin LEE <lsj119@samsung.com>
+ *
+ * Copyright (c) 2011 Samsung Electronics Co., Ltd All Rights Reserved 
+ *
+ * Permission to use, copy, modify, distribute, and sell this software
+ * and its documentation for any purpose is hereby granted without
+ * fee, provided that the above copyright notice appear in all copies
+ * and that both that copyright notice and this permission notice
+ * appear in supporting documentation, and that the name of Red Hat
+ * not be used in advertising or publicity pertaining to distribution
+ * of the software without specific, written prior permission.  Red
+ * Hat makes no representations about the suitability of this software
+ * for any purpose.  It is provided "as is" without express or implied
+ * warranty.
+ *
+ * THE AUTHORS DISCLAIM ALL WARRANTIES WITH REGARD TO THIS SOFTWARE,
+ * INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS, IN
+ * NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY SPECIAL, INDIRECT OR
+ * CONSEQUENTIAL DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS
+ * OF USE, DATA OR PROFITS, WHETHER IN AN ACTION OF CONTRACT,
+ * NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN
+ * CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ *
+ */
+
+/*
+ * Wakeup descriptor for gesture consumers.
+ *
+ * The descriptor becomes readable once a gesture event has been decoded
+ * into the Xlib event queue and stays readable until the consumer calls
+ * XGestureClearEventFd().  Only the first event after a clear costs a
+ * write(), later ones just see the pending flag.
+ *
+ * Decoding happens whenever some thread reads the connection (for example
+ * the main loop, or Xlib's internal reading with XInitThreads), so a
+ * gesture thread can block on this descriptor and sleep through core
+ * traffic it is not interested in.
+ */
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+#include <X11/Xlibint.h>
+#include <X11/extensions/Xext.h>
+#include <X11/extensions/extutil.h>
+#include <X11/extensions/gesture.h>
+#include "gestureint.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#ifdef HAVE_SYS_EVENTFD_H
+#include <sys/eventfd.h>
+#endif
+
+static Bool
+notify_open(GestureDisplayPrivPtr priv)
+{
+    int fds[2], i;
+
+#ifdef HAVE_SYS_EVENTFD_H
+    fds[0] = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+    if (fds[0] >= 0) {
+	priv->notify_fd[0] = priv->notify_fd[1] = fds[0];
+	return True;
+    }
+#endif
+
+    if (pipe(fds) < 0)
+	return False;
+
+    for (i = 0; i < 2; i++) {
+	fcntl(fds[i], F_SETFD, FD_CLOEXEC);
+	fcntl(fds[i], F_SETFL, fcntl(fds[i], F_GETFL) | O_NONBLOCK);
+    }
+    priv->notify_fd[0] = fds[0];
+    priv->notify_fd[1] = fds[1];
+
+    return True;
+}
+
+void
+_XGestureNotifyInit(GestureDisplayPrivPtr priv)
+{
+    priv->notify_fd[0] = priv->notify_fd[1] = -1;
+    priv->notify_pending = False;
+}
+
+void
+_XGestureNotifyClose(GestureDisplayPrivPtr priv)
+{
+    if (priv->notify_fd[0] < 0)
+	return;
+
+    close(priv->notify_fd[0]);
+    if (priv->notify_fd[1] != priv->notify_fd[0])
+	close(priv->notify_fd[1]);
+    _XGestureNotifyInit(priv);
+}
+
+void
+_XGestureNotifyEvent(GestureDisplayPrivPtr priv)
+{
+#ifdef HAVE_SYS_EVENTFD_H
+    uint64_t one = 1;
+#else
+    char one = 1;
+#endif
+
+    if (priv->notify_pending)
+	return;
+
+    /* EAGAIN means the descriptor is already readable, which is all we want */
+    while (write(priv->notify_fd[1], &one, sizeof(one)) < 0 && errno == EINTR)
+	;
+    priv->notify_pending = True;
+}
+
+int
+XGestureGetEventFd(Display* dpy)
+{
+    XExtDisplayInfo *info = _XGestureFindDisplay (dpy);
+    GestureDisplayPrivPtr priv;
+    int fd;
+
+    TRACE("GetEventFd...");
+    GestureCheckExtension (dpy, info, -1);
+    priv = GesturePriv(info);
+
+    LockDisplay(dpy);
+    if (priv->notify_fd[0] < 0 && !notify_open(priv)) {
+	UnlockDisplay(dpy);
+	TRACE("GetEventFd... return -1");
+	return -1;
+    }
+    fd = priv->notify_fd[0];
+    UnlockDisplay(dpy);
+
+    return fd;
+}
+
+void
+XGestureClearEventFd(Display* dpy)
+{
+    XExtDisplayInfo *info = _XGestureFindDisplay (dpy);
+    GestureDisplayPrivPtr priv;
+    char buf[64];
+
+    GestureSimpleCheckExtension (dpy, info);
+    priv = GesturePriv(info);
+
+    LockDisplay(dpy);
+    if (priv->notify_fd[0] >= 0 && priv->notify_pending) {
+	while (read(priv->notify_fd[0], buf, sizeof(buf)) > 0)
+	    ;
+	priv->notify_pending = False;
+    }
+    UnlockDisplay(dpy);
+}
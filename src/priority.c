@@ -0,0 +1,226 @@
+/*
+ *
+ * libxgesture
+ *
+ * Contact: Sung-Jin Park <sj76.park@samsung.com>
+ *          Sangjin LEE <lsj119@samsung.com>
+ *
+ * Copyright (c) 2011 Samsung Electronics Co., Ltd All Rights Reserved 
+ *
+ * Permission to use, copy, modify, distribute, and sell this software
+ * and its documentation for any purpose is hereby granted without
+ * fee, provided that the above copyright notice appear in all copies
+ * and that both that copyright notice and this permission notice
+ * appear in supporting documentation, and that the name of Red Hat
+ * not be used in advertising or publicity pertaining to distribution
+ * of the software without specific, written prior permission.  Red
+ * Hat makes no representations about the suitability of this software
+ * for any purpose.  It is provided "as is" without express or implied
+ * warranty.
+ *
+ * THE AUTHORS DISCLAIM ALL WARRANTIES WITH REGARD TO THIS SOFTWARE,
+ * INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS, IN
+ * NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY SPECIAL, INDIRECT OR
+ * CONSEQUENTIAL DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS
+ * OF USE, DATA OR PROFITS, WHETHER IN AN ACTION OF CONTRACT,
+ * NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN
+ * CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ *
+ */
+
+/*
+ * Priority dispatch of gesture events.
+ *
+ * While enabled, decoded gesture events bypass the Xlib event queue and go
+ * to a small per-display ring instead, fetched with
+ * XGestureNextPriorityEvent().  A client can then handle gestures before
+ * the Expose and damage events queued ahead of them.
+ *
+ * For instrumentation every event records the number of core events it
+ * skipped and the time it spent in the ring until it was fetched.
+ */
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+#include <X11/Xlibint.h>
+#include <X11/extensions/Xext.h>
+#include <X11/extensions/extutil.h>
+#include <X11/extensions/gesture.h>
+#include "gestureint.h"
+
+#include <time.h>
+
+#define PRIORITY_QUEUE_SIZE	256
+
+typedef struct {
+    XEvent event;
+    unsigned long long enqueue_usec;
+} PriorityEntry;
+
+typedef struct _GesturePriorityRec {
+    PriorityEntry entries[PRIORITY_QUEUE_SIZE];
+    int head;			/* next entry to fetch */
+    int count;
+    XGesturePriorityStats stats;
+} GesturePriorityRec;
+
+static unsigned long long
+now_usec(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (unsigned long long)ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+}
+
+Bool
+_XGesturePriorityEnqueue(Display *dpy, GesturePriorityPtr queue, XEvent *event)
+{
+    PriorityEntry *e;
+
+    /* when the client falls behind, regular delivery is the safe fallback */
+    if (queue->count == PRIORITY_QUEUE_SIZE) {
+	queue->stats.overflowed++;
+	return False;
+    }
+
+    e = &queue->entries[(queue->head + queue->count) % PRIORITY_QUEUE_SIZE];
+    e->event = *event;
+    e->enqueue_usec = now_usec();
+    queue->count++;
+
+    queue->stats.events_bypassed += dpy->qlen;
+
+    return True;
+}
+
+void
+_XGesturePriorityFree(GesturePriorityPtr queue)
+{
+    Xfree(queue);
+}
+
+static Bool
+dequeue(GesturePriorityPtr queue, XEvent *event_return)
+{
+    PriorityEntry *e;
+    unsigned long long wait;
+
+    if (!queue->count)
+	return False;
+
+    e = &queue->entries[queue->head];
+    *event_return = e->event;
+    queue->head = (queue->head + 1) % PRIORITY_QUEUE_SIZE;
+    queue->count--;
+
+    wait = now_usec() - e->enqueue_usec;
+    queue->stats.delivered++;
+    queue->stats.total_wait_usec += wait;
+    if (wait > queue->stats.max_wait_usec)
+	queue->stats.max_wait_usec = wait;
+
+    return True;
+}
+
+Bool
+XGestureSetPriorityDispatch(Display* dpy, Bool enable)
+{
+    XExtDisplayInfo *info = _XGestureFindDisplay (dpy);
+    GestureDisplayPrivPtr priv;
+    GesturePriorityPtr queue = NULL;
+    XEvent event;
+    int i;
+
+    TRACE("SetPriorityDispatch...");
+    GestureCheckExtension (dpy, info, False);
+    priv = GesturePriv(info);
+
+    if (enable && !(queue = Xcalloc(1, sizeof(GesturePriorityRec))))
+	return False;
+
+    LockDisplay(dpy);
+    if (enable) {
+	if (priv->priority) {
+	    Xfree(queue);
+	} else {
+	    priv->priority = queue;
+	}
+	UnlockDisplay(dpy);
+	return True;
+    }
+
+    queue = priv->priority;
+    priv->priority = NULL;
+    UnlockDisplay(dpy);
+
+    if (!queue)
+	return True;
+
+    /* hand pending events back to Xlib, still ahead of the queued core events */
+    for (i = queue->count - 1; i >= 0; i--) {
+	event = queue->entries[(queue->head + i) % PRIORITY_QUEUE_SIZE].event;
+	XPutBackEvent(dpy, &event);
+    }
+    _XGesturePriorityFree(queue);
+
+    return True;
+}
+
+int
+XGesturePendingPriorityEvents(Display* dpy)
+{
+    XExtDisplayInfo *info = _XGestureFindDisplay (dpy);
+    GesturePriorityPtr queue;
+    int count = 0;
+
+    GestureCheckExtension (dpy, info, 0);
+
+    LockDisplay(dpy);
+    if ((queue = GesturePriv(info)->priority)) {
+	if (!queue->count)
+	    _XEventsQueued(dpy, QueuedAfterReading);
+	count = queue->count;
+    }
+    UnlockDisplay(dpy);
+
+    return count;
+}
+
+Bool
+XGestureNextPriorityEvent(Display* dpy, XEvent *event_return)
+{
+    XExtDisplayInfo *info = _XGestureFindDisplay (dpy);
+    GesturePriorityPtr queue;
+    Bool found = False;
+
+    GestureCheckExtension (dpy, info, False);
+
+    LockDisplay(dpy);
+    if ((queue = GesturePriv(info)->priority)) {
+	/* pull in whatever the server has sent without blocking */
+	if (!queue->count)
+	    _XEventsQueued(dpy, QueuedAfterReading);
+	found = dequeue(queue, event_return);
+    }
+    UnlockDisplay(dpy);
+
+    return found;
+}
+
+Bool
+XGestureGetPriorityStats(Display* dpy, XGesturePriorityStats *stats_return)
+{
+    XExtDisplayInfo *info = _XGestureFindDisplay (dpy);
+    GesturePriorityPtr queue;
+
+    GestureCheckExtension (dpy, info, False);
+
+    LockDisplay(dpy);
+    if ((queue = GesturePriv(info)->priority))
+	*stats_return = queue->stats;
+    UnlockDisplay(dpy);
+
+    return queue != NULL;
+}
@@ -0,0 +1,540 @@
+/*
+ *
+ * libxgesture
+ *
+ * Contact: Sung-Jin Park <sj76.park@samsung.com>
+ *          Sangjin LEE <lsj119@samsung.com>
+ *
+ * Copyright (c) 2011 Samsung Electronics Co., Ltd All Rights Reserved 
+ *
+ * Permission to use, copy, modify, distribute, and sell this software
+ * and its documentation for any purpose is hereby granted without
+ * fee, provided that the above copyright notice appear in all copies
+ * and that both that copyright notice and this permission notice
+ * appear in supporting documentation, and that the name of Red Hat
+ * not be used in advertising or publicity pertaining to distribution
+ * of the software without specific, written prior permission.  Red
+ * Hat makes no representations about the suitability of this software
+ * for any purpose.  It is provided "as is" without express or implied
+ * warranty.
+ *
+ * THE AUTHORS DISCLAIM ALL WARRANTIES WITH REGARD TO THIS SOFTWARE,
+ * INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS, IN
+ * NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY SPECIAL, INDIRECT OR
+ * CONSEQUENTIAL DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS
+ * OF USE, DATA OR PROFITS, WHETHER IN AN ACTION OF CONTRACT,
+ * NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN
+ * CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ *
+ */
+
+/*
+ * Client side gesture recognizer.
+ *
+ * Fallback for servers without the gesture extension: raw touch samples
+ * (typically XI 2.2 touch events, see XGestureRecognizerFeedXI2() in
+ * gesture.h) are turned into the same XGestureNotify* structures the
+ * extension delivers.  All state lives in the fixed size recognizer, so
+ * feeding a sample never allocates.  Samples carry their own timestamps,
+ * which makes recorded traces replay deterministically.
+ *
+ * Conventions for the synthesized events:
+ *   - angles are radians counterclockwise from the positive x axis, y up;
+ *   - direction is the angle quantized to 8 steps, 0 pointing right;
+ *   - Tap, Flick and TapNHold/Hold releases are reported as GestureEnd.
+ */
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+#include <X11/Xlibint.h>
+#include <X11/extensions/gesture.h>
+#include <X11/extensions/gestureconst.h>
+
+#include <math.h>
+
+#define MAX_TOUCHES		5
+#define TAP_SLOP		20	/* px a touch may move and still tap */
+#define TAP_TIMEOUT		250	/* ms, longest press that is a tap */
+#define TAP_REPEAT_INTERVAL	300	/* ms between taps of a repeat */
+#define HOLD_TIME		500	/* ms before a still press is a hold */
+#define FLICK_MAX_DURATION	300	/* ms, longest pan that may flick */
+#define FLICK_MIN_SPEED		0.5	/* px/ms */
+
+enum {
+    STATE_IDLE,
+    STATE_DOWN,		/* touching, nothing recognized yet */
+    STATE_PAN,
+    STATE_PINCH,
+    STATE_HOLD,
+    STATE_TAPNHOLD,
+    STATE_DONE		/* gesture ended, waiting for all fingers up */
+};
+
+typedef struct {
+    Bool active;
+    int touchid;
+    int x, y;
+} TouchSlot;
+
+struct _XGestureRecognizer {
+    Display *dpy;
+    int event_base;
+
+    TouchSlot touches[MAX_TOUCHES];
+    int num_active;
+    int max_fingers;		/* fingers seen during this sequence */
+
+    int state;
+    Window window;
+    Time start_time;
+    int start_cx, start_cy;	/* centroid when the sequence started */
+    int last_cx, last_cy;	/* centroid at the previous pan update */
+
+    /* pinch reference */
+    double pinch_dist0;
+    double pinch_angle0;
+
+    /* previous tap, for tap_repeat and TapNHold */
+    Bool have_tap;
+    Time tap_time;
+    int tap_x, tap_y;
+    int tap_fingers;
+    int tap_repeat;
+};
+
+typedef struct {
+    XGestureCommonEvent *events;
+    int max;
+    int count;
+} Output;
+
+XGestureRecognizer *
+XGestureRecognizerCreate(Display *dpy, int event_base)
+{
+    XGestureRecognizer *rec = Xcalloc(1, sizeof(XGestureRecognizer));
+
+    if (rec) {
+	rec->dpy = dpy;
+	rec->event_base = event_base;
+    }
+
+    return rec;
+}
+
+void
+XGestureRecognizerDestroy(XGestureRecognizer *rec)
+{
+    Xfree(rec);
+}
+
+void
+XGestureRecognizerReset(XGestureRecognizer *rec)
+{
+    Display *dpy = rec->dpy;
+    int event_base = rec->event_base;
+
+    memset(rec, 0, sizeof(XGestureRecognizer));
+    rec->dpy = dpy;
+    rec->event_base = event_base;
+}
+
+static XGestureCommonEvent *
+emit(XGestureRecognizer *rec, Output *out, int type, int kind, Time time)
+{
+    XGestureCommonEvent *ev;
+
+    /* events beyond the caller's array are dropped */
+    if (out->count >= out->max)
+	return NULL;
+
+    ev = &out->events[out->count++];
+    memset(ev, 0, sizeof(XGestureCommonEvent));
+    ev->any.type = rec->event_base + type;
+    ev->any.display = rec->dpy;
+    ev->any.window = rec->window;
+    ev->any.time = time;
+    ev->any.kind = kind;
+
+    /* library side fields of the extension path: nothing known here */
+    switch (type) {
+	case GestureNotifyFlick: ev->fev.groupid = -1; break;
+	case GestureNotifyPan: ev->pev.groupid = -1; break;
+	case GestureNotifyPinchRotation: ev->pcrev.groupid = -1; break;
+	case GestureNotifyTap: ev->tev.groupid = -1; break;
+	case GestureNotifyTapNHold: ev->thev.groupid = -1; break;
+	case GestureNotifyHold: ev->hev.groupid = -1; break;
+    }
+
+    return ev;
+}
+
+static void
+centroid(XGestureRecognizer *rec, int *cx, int *cy)
+{
+    int i, n = 0, sx = 0, sy = 0;
+
+    for (i = 0; i < MAX_TOUCHES; i++) {
+	if (rec->touches[i].active) {
+	    sx += rec->touches[i].x;
+	    sy += rec->touches[i].y;
+	    n++;
+	}
+    }
+
+    *cx = n ? sx / n : rec->last_cx;
+    *cy = n ? sy / n : rec->last_cy;
+}
+
+/* distance and angle between the first two active touches */
+static Bool
+pinch_geometry(XGestureRecognizer *rec, double *dist, double *angle)
+{
+    TouchSlot *t[2];
+    int i, n = 0;
+
+    for (i = 0; i < MAX_TOUCHES && n < 2; i++) {
+	if (rec->touches[i].active)
+	    t[n++] = &rec->touches[i];
+    }
+    if (n < 2)
+	return False;
+
+    *dist = hypot(t[1]->x - t[0]->x, t[1]->y - t[0]->y);
+    *angle = atan2(-(double)(t[1]->y - t[0]->y), t[1]->x - t[0]->x);
+
+    return True;
+}
+
+/* a - b folded into (-pi, pi] */
+static double
+angle_diff(double a, double b)
+{
+    double d = a - b;
+
+    if (d > M_PI)
+	d -= 2 * M_PI;
+    else if (d <= -M_PI)
+	d += 2 * M_PI;
+
+    return d;
+}
+
+static int
+direction_of(int dx, int dy)
+{
+    double angle = atan2(-(double)dy, dx);
+
+    return ((int)lround(angle / (M_PI / 4)) + 8) % 8;
+}
+
+static int
+distance_of(int dx, int dy)
+{
+    return (int)lround(hypot(dx, dy));
+}
+
+static void
+pan_event(XGestureRecognizer *rec, Output *out, int kind, Time time)
+{
+    XGestureCommonEvent *ev;
+    int cx, cy;
+
+    centroid(rec, &cx, &cy);
+    if (!(ev = emit(rec, out, GestureNotifyPan, kind, time)))
+	return;
+
+    ev->pev.num_finger = rec->max_fingers;
+    ev->pev.dx = cx - rec->last_cx;
+    ev->pev.dy = cy - rec->last_cy;
+    ev->pev.direction = direction_of(cx - rec->start_cx, cy - rec->start_cy);
+    ev->pev.distance = distance_of(cx - rec->start_cx, cy - rec->start_cy);
+    ev->pev.duration = time - rec->start_time;
+
+    rec->last_cx = cx;
+    rec->last_cy = cy;
+}
+
+static void
+pinch_event(XGestureRecognizer *rec, Output *out, int kind, Time time)
+{
+    XGestureCommonEvent *ev;
+    double dist, angle;
+    int cx, cy;
+
+    if (!pinch_geometry(rec, &dist, &angle)) {
+	/* a finger went up: report the last known state */
+	dist = rec->pinch_dist0;
+	angle = rec->pinch_angle0;
+    }
+    centroid(rec, &cx, &cy);
+
+    if (!(ev = emit(rec, out, GestureNotifyPinchRotation, kind, time)))
+	return;
+
+    ev->pcrev.num_finger = rec->max_fingers;
+    ev->pcrev.cx = cx;
+    ev->pcrev.cy = cy;
+    ev->pcrev.distance = (int)lround(dist / 2);
+    ev->pcrev.zoom = XDoubleToFixed(rec->pinch_dist0 > 0 ?
+				    dist / rec->pinch_dist0 : 1.0);
+    ev->pcrev.angle = XDoubleToFixed(angle_diff(angle, rec->pinch_angle0));
+}
+
+static void
+hold_event(XGestureRecognizer *rec, Output *out, int kind, Time time)
+{
+    XGestureCommonEvent *ev;
+    int cx, cy;
+
+    centroid(rec, &cx, &cy);
+
+    if (rec->state == STATE_TAPNHOLD) {
+	if (!(ev = emit(rec, out, GestureNotifyTapNHold, kind, time)))
+	    return;
+	ev->thev.num_finger = rec->max_fingers;
+	ev->thev.cx = cx;
+	ev->thev.cy = cy;
+	ev->thev.interval = rec->start_time - rec->tap_time;
+	ev->thev.holdtime = time - rec->start_time;
+    } else {
+	if (!(ev = emit(rec, out, GestureNotifyHold, kind, time)))
+	    return;
+	ev->hev.num_finger = rec->max_fingers;
+	ev->hev.cx = cx;
+	ev->hev.cy = cy;
+	ev->hev.holdtime = time - rec->start_time;
+    }
+}
+
+/*
+ * A finger landing or lifting moves the centroid without any motion;
+ * shift the pan origin along so the jump never shows up in dx/dy.
+ */
+static void
+rebase_pan(XGestureRecognizer *rec)
+{
+    int cx, cy;
+
+    centroid(rec, &cx, &cy);
+    rec->start_cx += cx - rec->last_cx;
+    rec->start_cy += cy - rec->last_cy;
+    rec->last_cx = cx;
+    rec->last_cy = cy;
+}
+
+static void
+check_hold(XGestureRecognizer *rec, Output *out, Time now)
+{
+    if (rec->state != STATE_DOWN || (INT32)(now - rec->start_time) < HOLD_TIME)
+	return;
+
+    /* a press shortly after a tap is a tap-and-hold */
+    rec->state = (rec->have_tap &&
+		  rec->start_time - rec->tap_time <= TAP_REPEAT_INTERVAL) ?
+	STATE_TAPNHOLD : STATE_HOLD;
+    hold_event(rec, out, GestureBegin, now);
+    rec->have_tap = False;
+}
+
+static void
+release_all(XGestureRecognizer *rec, Output *out, Time time)
+{
+    XGestureCommonEvent *ev;
+    int dx, dy, distance;
+    Time duration = time - rec->start_time;
+
+    switch (rec->state) {
+	case STATE_PAN:
+	    pan_event(rec, out, GestureEnd, time);
+	    dx = rec->last_cx - rec->start_cx;
+	    dy = rec->last_cy - rec->start_cy;
+	    distance = distance_of(dx, dy);
+	    if (duration && duration <= FLICK_MAX_DURATION &&
+		(double)distance / duration >= FLICK_MIN_SPEED &&
+		(ev = emit(rec, out, GestureNotifyFlick, GestureEnd, time))) {
+		ev->fev.num_finger = rec->max_fingers;
+		ev->fev.direction = direction_of(dx, dy);
+		ev->fev.distance = distance;
+		ev->fev.duration = duration;
+		ev->fev.angle = XDoubleToFixed(atan2(-(double)dy, dx));
+	    }
+	    break;
+
+	case STATE_PINCH:
+	    pinch_event(rec, out, GestureEnd, time);
+	    break;
+
+	case STATE_HOLD:
+	case STATE_TAPNHOLD:
+	    hold_event(rec, out, GestureEnd, time);
+	    break;
+
+	case STATE_DOWN:
+	    if (duration > TAP_TIMEOUT)
+		break;
+	    if (rec->have_tap && rec->tap_fingers == rec->max_fingers &&
+		time - rec->tap_time <= TAP_REPEAT_INTERVAL &&
+		abs(rec->start_cx - rec->tap_x) <= TAP_SLOP &&
+		abs(rec->start_cy - rec->tap_y) <= TAP_SLOP)
+		rec->tap_repeat++;
+	    else
+		rec->tap_repeat = 1;
+
+	    if ((ev = emit(rec, out, GestureNotifyTap, GestureEnd, time))) {
+		ev->tev.num_finger = rec->max_fingers;
+		ev->tev.cx = rec->start_cx;
+		ev->tev.cy = rec->start_cy;
+		ev->tev.tap_repeat = rec->tap_repeat;
+		ev->tev.interval = rec->have_tap ? time - rec->tap_time : 0;
+	    }
+	    rec->have_tap = True;
+	    rec->tap_time = time;
+	    rec->tap_x = rec->start_cx;
+	    rec->tap_y = rec->start_cy;
+	    rec->tap_fingers = rec->max_fingers;
+	    break;
+    }
+
+    rec->state = STATE_IDLE;
+    rec->max_fingers = 0;
+}
+
+static TouchSlot *
+find_touch(XGestureRecognizer *rec, int touchid, Bool create)
+{
+    TouchSlot *free_slot = NULL;
+    int i;
+
+    for (i = 0; i < MAX_TOUCHES; i++) {
+	if (rec->touches[i].active && rec->touches[i].touchid == touchid)
+	    return &rec->touches[i];
+	if (!rec->touches[i].active && !free_slot)
+	    free_slot = &rec->touches[i];
+    }
+
+    return create ? free_slot : NULL;
+}
+
+int
+XGestureRecognizerFeed(XGestureRecognizer *rec, const XGestureTouchSample *sample,
+		       XGestureCommonEvent *events_return, int max_events)
+{
+    Output out = { events_return, max_events, 0 };
+    TouchSlot *touch;
+    double dist, angle;
+    int cx, cy;
+
+    check_hold(rec, &out, sample->time);
+
+    switch (sample->type) {
+	case XGestureTouchBegin:
+	    if (!(touch = find_touch(rec, sample->touchid, True)))
+		break;		/* more fingers than we track */
+	    touch->active = True;
+	    touch->touchid = sample->touchid;
+	    touch->x = sample->x;
+	    touch->y = sample->y;
+	    rec->num_active++;
+	    if (rec->num_active > rec->max_fingers)
+		rec->max_fingers = rec->num_active;
+
+	    if (rec->state == STATE_IDLE) {
+		rec->state = STATE_DOWN;
+		rec->window = sample->window;
+		rec->start_time = sample->time;
+		rec->start_cx = rec->last_cx = sample->x;
+		rec->start_cy = rec->last_cy = sample->y;
+		if (rec->have_tap &&
+		    sample->time - rec->tap_time > TAP_REPEAT_INTERVAL)
+		    rec->have_tap = False;
+	    } else if (rec->state == STATE_DOWN) {
+		centroid(rec, &cx, &cy);
+		rec->start_cx = rec->last_cx = cx;
+		rec->start_cy = rec->last_cy = cy;
+		/* remember the spread the fingers started with */
+		if (rec->num_active == 2 && pinch_geometry(rec, &dist, &angle)) {
+		    rec->pinch_dist0 = dist;
+		    rec->pinch_angle0 = angle;
+		}
+	    } else if (rec->state == STATE_PAN) {
+		rebase_pan(rec);
+	    }
+	    break;
+
+	case XGestureTouchUpdate:
+	    if (!(touch = find_touch(rec, sample->touchid, False)))
+		break;
+	    touch->x = sample->x;
+	    touch->y = sample->y;
+	    centroid(rec, &cx, &cy);
+
+	    if (rec->state == STATE_DOWN && rec->num_active >= 2 &&
+		pinch_geometry(rec, &dist, &angle) &&
+		(fabs(dist - rec->pinch_dist0) > TAP_SLOP ||
+		 fabs(angle_diff(angle, rec->pinch_angle0)) > M_PI / 12)) {
+		rec->state = STATE_PINCH;
+		pinch_event(rec, &out, GestureBegin, sample->time);
+	    } else if (rec->state == STATE_DOWN &&
+		       (abs(cx - rec->start_cx) > TAP_SLOP ||
+			abs(cy - rec->start_cy) > TAP_SLOP)) {
+		rec->state = STATE_PAN;
+		pan_event(rec, &out, GestureBegin, sample->time);
+	    } else if (rec->state == STATE_PAN) {
+		pan_event(rec, &out, GestureUpdate, sample->time);
+	    } else if (rec->state == STATE_PINCH) {
+		pinch_event(rec, &out, GestureUpdate, sample->time);
+	    } else if ((rec->state == STATE_HOLD || rec->state == STATE_TAPNHOLD) &&
+		       (abs(cx - rec->start_cx) > TAP_SLOP ||
+			abs(cy - rec->start_cy) > TAP_SLOP)) {
+		/* moving ends a hold without turning it into a pan */
+		hold_event(rec, &out, GestureEnd, sample->time);
+		rec->state = STATE_DONE;
+	    }
+	    break;
+
+	case XGestureTouchEnd:
+	    if (!(touch = find_touch(rec, sample->touchid, False)))
+		break;
+	    touch->x = sample->x;
+	    touch->y = sample->y;
+
+	    if (rec->num_active == 1) {
+		/* keep the final position in the centroid of the last event */
+		centroid(rec, &cx, &cy);
+		if (rec->state == STATE_PAN && (cx != rec->last_cx || cy != rec->last_cy))
+		    pan_event(rec, &out, GestureUpdate, sample->time);
+		release_all(rec, &out, sample->time);
+	    } else if (rec->state == STATE_PINCH) {
+		pinch_event(rec, &out, GestureEnd, sample->time);
+		rec->state = STATE_DONE;
+	    } else if (rec->state == STATE_PAN) {
+		/* deliver the lifting finger's last motion before it leaves */
+		centroid(rec, &cx, &cy);
+		if (cx != rec->last_cx || cy != rec->last_cy)
+		    pan_event(rec, &out, GestureUpdate, sample->time);
+	    }
+	    touch->active = False;
+	    if (--rec->num_active == 0) {
+		rec->pinch_dist0 = 0;
+		rec->state = STATE_IDLE;
+		rec->max_fingers = 0;
+	    } else if (rec->state == STATE_PAN || rec->state == STATE_DOWN) {
+		rebase_pan(rec);
+	    }
+	    break;
+    }
+
+    return out.count;
+}
+
+int
+XGestureRecognizerTimeout(XGestureRecognizer *rec, Time now,
+			  XGestureCommonEvent *events_return, int max_events)
+{
+    Output out = { events_return, max_events, 0 };
+
+    check_hold(rec, &out, now);
+
+    return out.count;
+}
@@ -0,0 +1,407 @@
+/*
+ *
+ * libxgesture
+ *
+ * Contact: Sung-Jin Park <sj76.park@samsung.com>
+ *          Sangjin LEE <lsj119@samsung.com>
+ *
+ * Copyright (c) 2011 Samsung Electronics Co., Ltd All Rights Reserved 
+ *
+ * Permission to use, copy, modify, distribute, and sell this software
+ * and its documentation for any purpose is hereby granted without
+ * fee, provided that the above copyright notice appear in all copies
+ * and that both that copyright notice and this permission notice
+ * appear in supporting documentation, and that the name of Red Hat
+ * not be used in advertising or publicity pertaining to distribution
+ * of the software without specific, written prior permission.  Red
+ * Hat makes no representations about the suitability of this software
+ * for any purpose.  It is provided "as is" without express or implied
+ * warranty.
+ *
+ * THE AUTHORS DISCLAIM ALL WARRANTIES WITH REGARD TO THIS SOFTWARE,
+ * INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS, IN
+ * NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY SPECIAL, INDIRECT OR
+ * CONSEQUENTIAL DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS
+ * OF USE, DATA OR PROFITS, WHETHER IN AN ACTION OF CONTRACT,
+ * NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN
+ * CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ *
+ */
+
+/*
+ * Per-window hit-test index of client registered sub-rectangles.
+ *
+ * Regions are bucketed into a uniform grid of at most REGION_GRID_MAX cells
+ * per axis, stored CSR style (cell_start/cell_items).  A lookup visits one
+ * cell and checks only the regions overlapping it, newest first, because a
+ * later registration stacks above earlier ones.  The grid is rebuilt lazily
+ * on the first lookup after a change.
+ *
+ * Regions are window relative, so events are only resolved on windows
+ * whose geometry is tracked (XGestureTrackWindowGeometry()).  They are
+ * clamped to the 16-bit X coordinate range when added.
+ *
+ * Only events with a position (Tap, TapNHold, Hold, PinchRotation) are
+ * hit-tested.  Pan and Flick carry none on the wire, so they are not routed
+ * by position: they inherit the target of the located gesture still in
+ * progress on the window, or get 0.
+ */
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+#include <X11/Xlibint.h>
+#include <X11/extensions/Xext.h>
+#include <X11/extensions/extutil.h>
+#include <X11/extensions/gesture.h>
+#include "gestureint.h"
+
+#include <limits.h>
+
+#define REGION_GRID_MAX		64
+#define REGION_MIN_CELL		32
+
+typedef struct {
+    unsigned long id;
+    int x1, y1, x2, y2;		/* x2/y2 exclusive */
+} RegionRec;
+
+typedef struct _GestureRegionsRec {
+    RegionRec *regions;
+    int num_regions;
+    int size;
+
+    /* grid, valid unless dirty */
+    Bool dirty;
+    int origin_x, origin_y;
+    int cell_w, cell_h;
+    int cols, rows;
+    int *cell_start;		/* cols * rows + 1 offsets into cell_items */
+    int *cell_items;		/* region indices, ascending per cell */
+} GestureRegionsRec;
+
+void
+_XGestureRegionsFree(GestureRegionsPtr regions)
+{
+    if (!regions)
+	return;
+
+    Xfree(regions->regions);
+    Xfree(regions->cell_start);
+    Xfree(regions->cell_items);
+    Xfree(regions);
+}
+
+static void
+cell_range(GestureRegionsPtr r, RegionRec *reg, int *c1, int *r1, int *c2, int *r2)
+{
+    *c1 = (reg->x1 - r->origin_x) / r->cell_w;
+    *r1 = (reg->y1 - r->origin_y) / r->cell_h;
+    *c2 = (reg->x2 - 1 - r->origin_x) / r->cell_w;
+    *r2 = (reg->y2 - 1 - r->origin_y) / r->cell_h;
+}
+
+static Bool
+build_grid(GestureRegionsPtr r)
+{
+    int min_x, min_y, max_x, max_y;
+    int c1, r1, c2, r2, c, row;
+    int ncells, total, i, *fill;
+
+    Xfree(r->cell_start);
+    Xfree(r->cell_items);
+    r->cell_start = r->cell_items = NULL;
+    r->cols = r->rows = 0;
+
+    if (!r->num_regions) {
+	r->dirty = False;
+	return True;
+    }
+
+    min_x = min_y = INT_MAX;
+    max_x = max_y = INT_MIN;
+    for (i = 0; i < r->num_regions; i++) {
+	if (r->regions[i].x1 < min_x) min_x = r->regions[i].x1;
+	if (r->regions[i].y1 < min_y) min_y = r->regions[i].y1;
+	if (r->regions[i].x2 > max_x) max_x = r->regions[i].x2;
+	if (r->regions[i].y2 > max_y) max_y = r->regions[i].y2;
+    }
+
+    r->origin_x = min_x;
+    r->origin_y = min_y;
+    r->cell_w = (max_x - min_x + REGION_GRID_MAX - 1) / REGION_GRID_MAX;
+    r->cell_h = (max_y - min_y + REGION_GRID_MAX - 1) / REGION_GRID_MAX;
+    if (r->cell_w < REGION_MIN_CELL) r->cell_w = REGION_MIN_CELL;
+    if (r->cell_h < REGION_MIN_CELL) r->cell_h = REGION_MIN_CELL;
+    r->cols = (max_x - min_x + r->cell_w - 1) / r->cell_w;
+    r->rows = (max_y - min_y + r->cell_h - 1) / r->cell_h;
+    ncells = r->cols * r->rows;
+
+    if (!(r->cell_start = Xcalloc(ncells + 1, sizeof(int))))
+	return False;
+
+    /* count, prefix sum, then fill in region order */
+    for (i = 0; i < r->num_regions; i++) {
+	cell_range(r, &r->regions[i], &c1, &r1, &c2, &r2);
+	for (row = r1; row <= r2; row++)
+	    for (c = c1; c <= c2; c++)
+		r->cell_start[row * r->cols + c + 1]++;
+    }
+    for (i = 0; i < ncells; i++)
+	r->cell_start[i + 1] += r->cell_start[i];
+
+    total = r->cell_start[ncells];
+    r->cell_items = Xmalloc((total ? total : 1) * sizeof(int));
+    fill = Xmalloc(ncells * sizeof(int));
+    if (!r->cell_items || !fill) {
+	Xfree(fill);
+	return False;
+    }
+    memcpy(fill, r->cell_start, ncells * sizeof(int));
+
+    for (i = 0; i < r->num_regions; i++) {
+	cell_range(r, &r->regions[i], &c1, &r1, &c2, &r2);
+	for (row = r1; row <= r2; row++)
+	    for (c = c1; c <= c2; c++)
+		r->cell_items[fill[row * r->cols + c]++] = i;
+    }
+    Xfree(fill);
+
+    r->dirty = False;
+    return True;
+}
+
+static unsigned long
+lookup(GestureRegionsPtr r, int x, int y)
+{
+    RegionRec *reg;
+    int c, row, cell, i;
+
+    if (r->dirty && !build_grid(r))
+	return 0;
+
+    if (!r->cols || x < r->origin_x || y < r->origin_y)
+	return 0;
+
+    c = (x - r->origin_x) / r->cell_w;
+    row = (y - r->origin_y) / r->cell_h;
+    if (c >= r->cols || row >= r->rows)
+	return 0;
+
+    cell = row * r->cols + c;
+    for (i = r->cell_start[cell + 1] - 1; i >= r->cell_start[cell]; i--) {
+	reg = &r->regions[r->cell_items[i]];
+	if (x >= reg->x1 && x < reg->x2 && y >= reg->y1 && y < reg->y2)
+	    return reg->id;
+    }
+
+    return 0;
+}
+
+void
+_XGestureRegionsResolve(GestureWindowPtr win, int type, XEvent *event)
+{
+    XGestureCommonEvent *ev = (XGestureCommonEvent *)event;
+    unsigned long *target;
+    Bool has_local;
+    int x, y;
+
+    switch (type) {
+	case GestureNotifyPinchRotation:
+	    target = &ev->pcrev.target;
+	    has_local = ev->pcrev.has_local;
+	    x = ev->pcrev.local_x;
+	    y = ev->pcrev.local_y;
+	    break;
+	case GestureNotifyTap:
+	    target = &ev->tev.target;
+	    has_local = ev->tev.has_local;
+	    x = ev->tev.local_x;
+	    y = ev->tev.local_y;
+	    break;
+	case GestureNotifyTapNHold:
+	    target = &ev->thev.target;
+	    has_local = ev->thev.has_local;
+	    x = ev->thev.local_x;
+	    y = ev->thev.local_y;
+	    break;
+	case GestureNotifyHold:
+	    target = &ev->hev.target;
+	    has_local = ev->hev.has_local;
+	    x = ev->hev.local_x;
+	    y = ev->hev.local_y;
+	    break;
+
+	/* no position on the wire, share the located gesture in progress */
+	case GestureNotifyFlick:
+	    ev->fev.target = win ? win->last_target : 0;
+	    return;
+	case GestureNotifyPan:
+	    ev->pev.target = win ? win->last_target : 0;
+	    return;
+
+	default:
+	    return;
+    }
+
+    /* regions are window relative: without tracked geometry nothing hits */
+    *target = (win && win->regions && has_local) ?
+	lookup(win->regions, x, y) : 0;
+    /* a finished gesture must not route later pans and flicks */
+    if (win)
+	win->last_target = ev->any.kind == GestureEnd ? 0 : *target;
+}
+
+/* X coordinates are 16 bits; keeps the grid arithmetic in range too */
+static int
+clamp_coord(int v)
+{
+    return v < SHRT_MIN ? SHRT_MIN : v > SHRT_MAX ? SHRT_MAX : v;
+}
+
+Bool
+_XGestureRegionsAdd(GestureRegionsPtr *regions, unsigned long id,
+		    int x, int y, unsigned int width, unsigned int height)
+{
+    GestureRegionsPtr r;
+    RegionRec *reg = NULL;
+    int x1, y1, x2, y2;
+    void *p;
+    int i;
+
+    x1 = clamp_coord(x);
+    y1 = clamp_coord(y);
+    x2 = clamp_coord(x1 + (int)(width > USHRT_MAX ? USHRT_MAX : width));
+    y2 = clamp_coord(y1 + (int)(height > USHRT_MAX ? USHRT_MAX : height));
+    if (!id || x1 >= x2 || y1 >= y2)
+	return False;
+
+    if (!(r = *regions)) {
+	if (!(r = *regions = Xcalloc(1, sizeof(GestureRegionsRec))))
+	    return False;
+    }
+
+    /* re-registering an id moves it but keeps its stacking position */
+    for (i = 0; i < r->num_regions; i++) {
+	if (r->regions[i].id == id) {
+	    reg = &r->regions[i];
+	    break;
+	}
+    }
+
+    if (!reg) {
+	if (r->num_regions == r->size) {
+	    int size = r->size ? r->size * 2 : 16;
+
+	    if (!(p = Xrealloc(r->regions, size * sizeof(RegionRec))))
+		return False;
+	    r->regions = p;
+	    r->size = size;
+	}
+	reg = &r->regions[r->num_regions++];
+	reg->id = id;
+    }
+
+    reg->x1 = x1;
+    reg->y1 = y1;
+    reg->x2 = x2;
+    reg->y2 = y2;
+    r->dirty = True;
+
+    return True;
+}
+
+Bool
+XGestureAddRegion(Display* dpy, Window w, unsigned long id,
+		  int x, int y, unsigned int width, unsigned int height)
+{
+    XExtDisplayInfo *info = _XGestureFindDisplay (dpy);
+    GestureDisplayPrivPtr priv;
+    GestureWindowPtr win;
+
+    GestureCheckExtension (dpy, info, False);
+    priv = GesturePriv(info);
+
+    if (!id || !width || !height)
+	return False;
+
+    LockDisplay(dpy);
+    if (!(win = _XGestureFindWindow(priv, w, True)))
+	goto fail;
+    if (!_XGestureRegionsAdd(&win->regions, id, x, y, width, height))
+	goto fail;
+    UnlockDisplay(dpy);
+
+    return True;
+
+fail:
+    if (win)
+	_XGesturePruneWindow(priv, win);
+    UnlockDisplay(dpy);
+    return False;
+}
+
+Bool
+XGestureRemoveRegion(Display* dpy, Window w, unsigned long id)
+{
+    XExtDisplayInfo *info = _XGestureFindDisplay (dpy);
+    GestureDisplayPrivPtr priv;
+    GestureWindowPtr win;
+    GestureRegionsPtr r;
+    int i;
+
+    GestureCheckExtension (dpy, info, False);
+    priv = GesturePriv(info);
+
+    LockDisplay(dpy);
+    win = _XGestureFindWindow(priv, w, False);
+    if (!win || !(r = win->regions)) {
+	UnlockDisplay(dpy);
+	return False;
+    }
+
+    for (i = 0; i < r->num_regions; i++) {
+	if (r->regions[i].id == id)
+	    break;
+    }
+    if (i == r->num_regions) {
+	UnlockDisplay(dpy);
+	return False;
+    }
+
+    memmove(&r->regions[i], &r->regions[i + 1],
+	    (r->num_regions - i - 1) * sizeof(RegionRec));
+    r->num_regions--;
+    r->dirty = True;
+    if (win->last_target == id)
+	win->last_target = 0;
+
+    if (!r->num_regions) {
+	_XGestureRegionsFree(r);
+	win->regions = NULL;
+	_XGesturePruneWindow(priv, win);
+    }
+    UnlockDisplay(dpy);
+
+    return True;
+}
+
+void
+XGestureClearRegions(Display* dpy, Window w)
+{
+    XExtDisplayInfo *info = _XGestureFindDisplay (dpy);
+    GestureDisplayPrivPtr priv;
+    GestureWindowPtr win;
+
+    GestureSimpleCheckExtension (dpy, info);
+    priv = GesturePriv(info);
+
+    LockDisplay(dpy);
+    if ((win = _XGestureFindWindow(priv, w, False)) && win->regions) {
+	_XGestureRegionsFree(win->regions);
+	win->regions = NULL;
+	win->last_target = 0;
+	_XGesturePruneWindow(priv, win);
+    }
+    UnlockDisplay(dpy);
+}
@@ -0,0 +1,237 @@
+/*
+ *
+ * libxgesture
+ *
+ * Contact: Sung-Jin Park <sj76.park@samsung.com>
+ *          Sangjin LEE <lsj119@samsung.com>
+ *
+ * Copyright (c) 2011 Samsung Electronics Co., Ltd All Rights Reserved 
+ *
+ * Permission to use, copy, modify, distribute, and sell this software
+ * and its documentation for any purpose is hereby granted without
+ * fee, provided that the above copyright notice appear in all copies
+ * and that both that copyright notice and this permission notice
+ * appear in supporting documentation, and that the name of Red Hat
+ * not be used in advertising or publicity pertaining to distribution
+ * of the software without specific, written prior permission.  Red
+ * Hat makes no representations about the suitability of this software
+ * for any purpose.  It is provided "as is" without express or implied
+ * warranty.
+ *
+ * THE AUTHORS DISCLAIM ALL WARRANTIES WITH REGARD TO THIS SOFTWARE,
+ * INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS, IN
+ * NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY SPECIAL, INDIRECT OR
+ * CONSEQUENTIAL DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS
+ * OF USE, DATA OR PROFITS, WHETHER IN AN ACTION OF CONTRACT,
+ * NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN
+ * CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ *
+ */
+
+/*
+ * Streaming gesture telemetry.
+ *
+ * Every decoded gesture event is written as one fixed size binary record
+ * into a memory-mapped, size capped ring file (see telemetry.h).  Writing
+ * a record is a handful of stores into the mapping; the kernel takes care
+ * of getting the pages to disk, so the decode path never formats text or
+ * issues a system call.
+ */
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+#include <X11/Xlibint.h>
+#include <X11/extensions/Xext.h>
+#include <X11/extensions/extutil.h>
+#include <X11/extensions/gesture.h>
+#include "gestureint.h"
+#include "telemetry.h"
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#define TELEMETRY_MIN_SLOTS	16
+
+typedef struct _GestureTelemetryRec {
+    void *map;
+    size_t map_size;
+    GestureTelemetryHeader *header;
+    GestureTelemetryRecord *slots;
+} GestureTelemetryRec;
+
+static Bool
+header_matches(GestureTelemetryHeader *h, uint32_t num_slots)
+{
+    return h->magic == GESTURE_TELEMETRY_MAGIC &&
+	h->version == GESTURE_TELEMETRY_VERSION &&
+	h->header_size == sizeof(GestureTelemetryHeader) &&
+	h->slot_size == sizeof(GestureTelemetryRecord) &&
+	h->num_slots == num_slots;
+}
+
+static GestureTelemetryPtr
+telemetry_open(const char *path, unsigned int max_bytes)
+{
+    GestureTelemetryPtr t;
+    GestureTelemetryHeader *h;
+    uint32_t num_slots;
+    size_t size;
+    void *map;
+    int fd;
+
+    if (max_bytes < sizeof(GestureTelemetryHeader))
+	return NULL;
+    num_slots = (max_bytes - sizeof(GestureTelemetryHeader)) /
+	sizeof(GestureTelemetryRecord);
+    if (num_slots < TELEMETRY_MIN_SLOTS)
+	return NULL;
+    size = sizeof(GestureTelemetryHeader) +
+	num_slots * sizeof(GestureTelemetryRecord);
+
+    if ((fd = open(path, O_RDWR | O_CREAT | O_CLOEXEC, 0600)) < 0)
+	return NULL;
+    if (ftruncate(fd, size) < 0) {
+	close(fd);
+	return NULL;
+    }
+    map = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (map == MAP_FAILED)
+	return NULL;
+
+    if (!(t = Xcalloc(1, sizeof(GestureTelemetryRec)))) {
+	munmap(map, size);
+	return NULL;
+    }
+    t->map = map;
+    t->map_size = size;
+    t->header = h = map;
+    t->slots = (GestureTelemetryRecord *)(h + 1);
+
+    /* keep rolling an existing file of the same geometry */
+    if (!header_matches(h, num_slots)) {
+	memset(h, 0, sizeof(GestureTelemetryHeader));
+	h->magic = GESTURE_TELEMETRY_MAGIC;
+	h->version = GESTURE_TELEMETRY_VERSION;
+	h->header_size = sizeof(GestureTelemetryHeader);
+	h->slot_size = sizeof(GestureTelemetryRecord);
+	h->num_slots = num_slots;
+    }
+
+    return t;
+}
+
+void
+_XGestureTelemetryClose(GestureTelemetryPtr t)
+{
+    if (!t)
+	return;
+
+    munmap(t->map, t->map_size);
+    Xfree(t);
+}
+
+void
+_XGestureTelemetryRecord(GestureTelemetryPtr t, int type, XEvent *event)
+{
+    XGestureCommonEvent *ev = (XGestureCommonEvent *)event;
+    GestureTelemetryHeader *h = t->header;
+    uint64_t n = h->records_written;
+    GestureTelemetryRecord *rec = &t->slots[n % h->num_slots];
+
+    rec->length = sizeof(GestureTelemetryRecord);
+    rec->type = type;
+    rec->kind = ev->any.kind;
+    rec->reserved = 0;
+    rec->time = ev->any.time;
+    rec->window = ev->any.window;
+    rec->num_finger = 0;
+    rec->direction = 0;
+    rec->duration = 0;
+    rec->distance = 0;
+
+    switch (type) {
+	case GestureNotifyGroup:
+	    rec->num_finger = ev->gev.num_group;
+	    break;
+	case GestureNotifyFlick:
+	    rec->num_finger = ev->fev.num_finger;
+	    rec->direction = ev->fev.direction;
+	    rec->duration = ev->fev.duration;
+	    rec->distance = ev->fev.distance;
+	    break;
+	case GestureNotifyPan:
+	    rec->num_finger = ev->pev.num_finger;
+	    rec->direction = ev->pev.direction;
+	    rec->duration = ev->pev.duration;
+	    rec->distance = ev->pev.distance;
+	    break;
+	case GestureNotifyPinchRotation:
+	    rec->num_finger = ev->pcrev.num_finger;
+	    rec->distance = ev->pcrev.distance;
+	    break;
+	case GestureNotifyTap:
+	    rec->num_finger = ev->tev.num_finger;
+	    rec->duration = ev->tev.interval;
+	    break;
+	case GestureNotifyTapNHold:
+	    rec->num_finger = ev->thev.num_finger;
+	    rec->duration = ev->thev.holdtime;
+	    break;
+	case GestureNotifyHold:
+	    rec->num_finger = ev->hev.num_finger;
+	    rec->duration = ev->hev.holdtime;
+	    break;
+    }
+
+    /* publish only once the record is complete */
+    __atomic_store_n(&h->records_written, n + 1, __ATOMIC_RELEASE);
+}
+
+Bool
+XGestureStartTelemetry(Display* dpy, const char *path, unsigned int max_bytes)
+{
+    XExtDisplayInfo *info = _XGestureFindDisplay (dpy);
+    GestureDisplayPrivPtr priv;
+    GestureTelemetryPtr t, old;
+
+    TRACE("StartTelemetry...");
+    GestureCheckExtension (dpy, info, False);
+    priv = GesturePriv(info);
+
+    if (!path || !(t = telemetry_open(path, max_bytes))) {
+	TRACE("StartTelemetry... return False");
+	return False;
+    }
+
+    LockDisplay(dpy);
+    old = priv->telemetry;
+    priv->telemetry = t;
+    UnlockDisplay(dpy);
+
+    _XGestureTelemetryClose(old);
+    TRACE("StartTelemetry... return True");
+
+    return True;
+}
+
+void
+XGestureStopTelemetry(Display* dpy)
+{
+    XExtDisplayInfo *info = _XGestureFindDisplay (dpy);
+    GestureDisplayPrivPtr priv;
+    GestureTelemetryPtr t;
+
+    GestureSimpleCheckExtension (dpy, info);
+    priv = GesturePriv(info);
+
+    LockDisplay(dpy);
+    t = priv->telemetry;
+    priv->telemetry = NULL;
+    UnlockDisplay(dpy);
+
+    _XGestureTelemetryClose(t);
+}
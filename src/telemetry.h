@@ -0,0 +1,73 @@
+/*
+ *
+ * libxgesture
+ *
+ * Contact: Sung-Jin Park <sj76.park@samsung.com>
+ *          Sangjin LEE <lsj119@samsung.com>
+ *
+ * Copyright (c) 2011 Samsung Electronics Co., Ltd All Rights Reserved 
+ *
+ * Permission to use, copy, modify, distribute, and sell this software
+ * and its documentation for any purpose is hereby granted without
+ * fee, provided that the above copyright notice appear in all copies
+ * and that both that copyright notice and this permission notice
+ * appear in supporting documentation, and that the name of Red Hat
+ * not be used in advertising or publicity pertaining to distribution
+ * of the software without specific, written prior permission.  Red
+ * Hat makes no representations about the suitability of this software
+ * for any purpose.  It is provided "as is" without express or implied
+ * warranty.
+ *
+ * THE AUTHORS DISCLAIM ALL WARRANTIES WITH REGARD TO THIS SOFTWARE,
+ * INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS, IN
+ * NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY SPECIAL, INDIRECT OR
+ * CONSEQUENTIAL DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS
+ * OF USE, DATA OR PROFITS, WHETHER IN AN ACTION OF CONTRACT,
+ * NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN
+ * CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ *
+ */
+
+#ifndef _GESTURE_TELEMETRY_H_
+#define _GESTURE_TELEMETRY_H_
+
+/*
+ * On-disk layout of the gesture telemetry file, shared by the library and
+ * the xgesture-telemetry reader.  All values are in host byte order.
+ *
+ * The file is a header followed by num_slots fixed size slots used as a
+ * ring.  Record n lives in slot n % num_slots; once records_written exceeds
+ * num_slots the oldest records are overwritten.  Each record starts with
+ * its own length so that later versions can append fields while keeping
+ * the slot size in the header authoritative.
+ */
+
+#include <stdint.h>
+
+#define GESTURE_TELEMETRY_MAGIC		0x4c544758	/* "XGTL" */
+#define GESTURE_TELEMETRY_VERSION	1
+
+typedef struct {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t header_size;
+    uint32_t slot_size;
+    uint32_t num_slots;
+    uint32_t reserved;
+    uint64_t records_written;	/* updated after the record is complete */
+} GestureTelemetryHeader;
+
+typedef struct {
+    uint16_t length;		/* bytes of this record */
+    uint8_t type;		/* GestureNotifyGroup ... GestureNotifyHold */
+    uint8_t kind;		/* subevent type */
+    uint8_t num_finger;		/* num_group for group events */
+    uint8_t direction;
+    uint16_t reserved;
+    uint32_t time;		/* server time (ms) */
+    uint32_t duration;		/* duration, interval or hold time (ms) */
+    int32_t distance;
+    uint32_t window;
+} GestureTelemetryRecord;
+
+#endif//_GESTURE_TELEMETRY_H_
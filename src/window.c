@@ -0,0 +1,193 @@
+/*
+ *
+ * libxgesture
+ *
+ * Contact: Sung-Jin Park <sj76.park@samsung.com>
+ *          Sangjin LEE <lsj119@samsung.com>
+ *
+ * Copyright (c) 2011 Samsung Electronics Co., Ltd All Rights Reserved 
+ *
+ * Permission to use, copy, modify, distribute, and sell this software
+ * and its documentation for any purpose is hereby granted without
+ * fee, provided that the above copyright notice appear in all copies
+ * and that both that copyright notice and this permission notice
+ * appear in supporting documentation, and that the name of Red Hat
+ * not be used in advertising or publicity pertaining to distribution
+ * of the software without specific, written prior permission.  Red
+ * Hat makes no representations about the suitability of this software
+ * for any purpose.  It is provided "as is" without express or implied
+ * warranty.
+ *
+ * THE AUTHORS DISCLAIM ALL WARRANTIES WITH REGARD TO THIS SOFTWARE,
+ * INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS, IN
+ * NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY SPECIAL, INDIRECT OR
+ * CONSEQUENTIAL DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS
+ * OF USE, DATA OR PROFITS, WHETHER IN AN ACTION OF CONTRACT,
+ * NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN
+ * CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ *
+ */
+
+/*
+ * Per-window library state.
+ *
+ * Small chained hash keyed by window id.  Entries are created on demand by
+ * the features that need per-window state and pruned again once none of
+ * them uses the window any more.
+ */
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+#include <X11/Xlibint.h>
+#include <X11/extensions/Xext.h>
+#include <X11/extensions/extutil.h>
+#include <X11/extensions/gesture.h>
+#include "gestureint.h"
+
+GestureWindowPtr
+_XGestureFindWindow(GestureDisplayPrivPtr priv, Window w, Bool create)
+{
+    GestureWindowPtr *head = &priv->windows[GestureWindowHash(w)];
+    GestureWindowPtr win;
+
+    for (win = *head; win; win = win->next) {
+	if (win->window == w)
+	    return win;
+    }
+
+    if (!create || !(win = Xcalloc(1, sizeof(GestureWindowRec))))
+	return NULL;
+
+    win->window = w;
+    win->next = *head;
+    *head = win;
+
+    return win;
+}
+
+static void
+free_window(GestureWindowPtr win)
+{
+    int i;
+
+    _XGestureHistoryFree(win->history);
+    _XGestureRegionsFree(win->regions);
+    for (i = 0; i < GestureNumberEvents; i++)
+	_XGestureFilterFree(win->filters[i]);
+    Xfree(win);
+}
+
+void
+_XGesturePruneWindow(GestureDisplayPrivPtr priv, GestureWindowPtr win)
+{
+    GestureWindowPtr *prev;
+    int i;
+
+    if (win->history || win->track_geometry || win->regions ||
+	win->mask_known || win->has_group)
+	return;
+    for (i = 0; i < GestureNumberEvents; i++) {
+	if (win->grabbed[i] || win->filters[i])
+	    return;
+    }
+
+    for (prev = &priv->windows[GestureWindowHash(win->window)]; *prev;
+	 prev = &(*prev)->next) {
+	if (*prev == win) {
+	    *prev = win->next;
+	    free_window(win);
+	    return;
+	}
+    }
+}
+
+/* drop everything known about a destroyed window, its id may be reused */
+static void
+remove_window(GestureDisplayPrivPtr priv, Window w)
+{
+    GestureWindowPtr *prev, win;
+
+    for (prev = &priv->windows[GestureWindowHash(w)]; (win = *prev);
+	 prev = &win->next) {
+	if (win->window == w) {
+	    *prev = win->next;
+	    free_window(win);
+	    return;
+	}
+    }
+}
+
+void
+_XGestureFreeWindows(GestureDisplayPrivPtr priv)
+{
+    GestureWindowPtr win, next;
+    int i;
+
+    for (i = 0; i < GESTURE_WINDOW_HASH_SIZE; i++) {
+	for (win = priv->windows[i]; win; win = next) {
+	    next = win->next;
+	    free_window(win);
+	}
+	priv->windows[i] = NULL;
+    }
+}
+
+/*
+ * Core events that keep per-window state current.  The client still has to
+ * select StructureNotify on the windows it registers; this only piggybacks
+ * on decoding, it never changes event masks.
+ */
+static Bool
+core_wire_to_event(Display *dpy, XEvent *event, xEvent *wire)
+{
+    XExtDisplayInfo *info = _XGestureFindDisplay (dpy);
+    GestureDisplayPrivPtr priv;
+    int type = wire->u.u.type & 0x7f;
+
+    if (!info || !(priv = GesturePriv(info)) || !priv->core_wire_to_event[type])
+	return _XWireToEvent(dpy, event, wire);
+
+    if (!priv->core_wire_to_event[type](dpy, event, wire))
+	return False;
+
+    switch (event->type) {
+	case DestroyNotify:
+	    remove_window(priv, event->xdestroywindow.window);
+	    break;
+	case UnmapNotify:
+	    _XGestureForgetGrabs(priv, event->xunmap.window);
+	    break;
+	default:
+	    _XGestureGeometryCoreEvent(priv, event);
+	    break;
+    }
+
+    return True;
+}
+
+void
+_XGestureHookCoreEvents(Display *dpy, GestureDisplayPrivPtr priv)
+{
+    static const int types[] = {
+	ConfigureNotify, ReparentNotify, UnmapNotify, DestroyNotify
+    };
+    Bool (*prev)(Display *, XEvent *, xEvent *);
+    unsigned int i;
+
+    /*
+     * XESetWireToEvent() takes the display lock itself, so hold the user
+     * lock instead: it keeps other threads out between the check and the
+     * install, while this thread may still take the display lock.
+     */
+    XLockDisplay(dpy);
+    for (i = 0; i < sizeof(types) / sizeof(types[0]); i++) {
+	if (priv->core_wire_to_event[types[i]])
+	    continue;
+	prev = XESetWireToEvent(dpy, types[i], core_wire_to_event);
+	/* chaining to ourselves would recurse forever: use Xlib's decoder */
+	priv->core_wire_to_event[types[i]] =
+	    prev != core_wire_to_event ? prev : _XWireToEvent;
+    }
+    XUnlockDisplay(dpy);
+}
@@ -0,0 +1,60 @@
+/*
+ *
+ * libxgesture
+ *
+ * Contact: Sung-Jin Park <sj76.park@samsung.com>
+ *          Sangjin LEE <lsj119@samsung.com>
+ *
+ * Copyright (c) 2011 Samsung Electronics Co., Ltd All Rights Reserved 
+ *
+ * Permission to use, copy, modify, distribute, and sell this software
+ * and its documentation for any purpose is hereby granted without
+ * fee, provided that the above copyright notice appear in all copies
+ * and that both that copyright notice and this permission notice
+ * appear in supporting documentation, and that the name of Red Hat
+ * not be used in advertising or publicity pertaining to distribution
+ * of the software without specific, written prior permission.  Red
+ * Hat makes no representations about the suitability of this software
+ * for any purpose.  It is provided "as is" without express or implied
+ * warranty.
+ *
+ * THE AUTHORS DISCLAIM ALL WARRANTIES WITH REGARD TO THIS SOFTWARE,
+ * INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS, IN
+ * NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY SPECIAL, INDIRECT OR
+ * CONSEQUENTIAL DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS
+ * OF USE, DATA OR PROFITS, WHETHER IN AN ACTION OF CONTRACT,
+ * NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN
+ * CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ *
+ */
+
+/*
+ * Minimal assertion helpers shared by the unit tests.
+ */
+
+#ifndef _GESTURE_CHECK_H_
+#define _GESTURE_CHECK_H_
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#define CHECK(cond)							\
+    do {								\
+	if (!(cond)) {							\
+	    fprintf(stderr, "%s:%d: check failed: %s\n",		\
+		    __FILE__, __LINE__, #cond);				\
+	    exit(1);							\
+	}								\
+    } while (0)
+
+#define CHECK_INT(a, b)							\
+    do {								\
+	long long _a = (a), _b = (b);					\
+	if (_a != _b) {							\
+	    fprintf(stderr, "%s:%d: %s == %lld, expected %lld\n",	\
+		    __FILE__, __LINE__, #a, _a, _b);			\
+	    exit(1);							\
+	}								\
+    } while (0)
+
+#endif /* _GESTURE_CHECK_H_ */
@@ -0,0 +1,163 @@
+/*
+ *
+ * libxgesture
+ *
+ * Contact: Sung-Jin Park <sj76.park@samsung.com>
+ *          Sangjin LEE <lsj119@samsung.com>
+ *
+ * Copyright (c) 2011 Samsung Electronics Co., Ltd All Rights Reserved 
+ *
+ * Permission to use, copy, modify, distribute, and sell this software
+ * and its documentation for any purpose is hereby granted without
+ * fee, provided that the above copyright notice appear in all copies
+ * and that both that copyright notice and this permission notice
+ * appear in supporting documentation, and that the name of Red Hat
+ * not be used in advertising or publicity pertaining to distribution
+ * of the software without specific, written prior permission.  Red
+ * Hat makes no representations about the suitability of this software
+ * for any purpose.  It is provided "as is" without express or implied
+ * warranty.
+ *
+ * THE AUTHORS DISCLAIM ALL WARRANTIES WITH REGARD TO THIS SOFTWARE,
+ * INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS, IN
+ * NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY SPECIAL, INDIRECT OR
+ * CONSEQUENTIAL DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS
+ * OF USE, DATA OR PROFITS, WHETHER IN AN ACTION OF CONTRACT,
+ * NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN
+ * CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ *
+ */
+
+/*
+ * Event log append, iteration and serialize/load round trip.
+ */
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+#include <X11/Xlibint.h>
+#include <X11/extensions/gesture.h>
+#include <X11/extensions/gestureconst.h>
+#include "check.h"
+
+#define EVENT_BASE	64
+
+static void
+append_pan(XGestureEventLog *log, Window w, Time time, int dx, int dy)
+{
+    XGestureCommonEvent ev;
+
+    memset(&ev, 0, sizeof(ev));
+    ev.pev.type = EVENT_BASE + GestureNotifyPan;
+    ev.pev.kind = GestureUpdate;
+    ev.pev.window = w;
+    ev.pev.time = time;
+    ev.pev.num_finger = 2;
+    ev.pev.direction = 3;
+    ev.pev.dx = dx;
+    ev.pev.dy = dy;
+    ev.pev.distance = 42;
+    ev.pev.duration = 7;
+    CHECK(XGestureEventLogAppendEvent(log, EVENT_BASE, &ev));
+}
+
+static void
+append_pinch(XGestureEventLog *log, Window w, Time time)
+{
+    XGestureCommonEvent ev;
+
+    memset(&ev, 0, sizeof(ev));
+    ev.pcrev.type = EVENT_BASE + GestureNotifyPinchRotation;
+    ev.pcrev.kind = GestureEnd;
+    ev.pcrev.window = w;
+    ev.pcrev.time = time;
+    ev.pcrev.num_finger = 2;
+    ev.pcrev.cx = 320;
+    ev.pcrev.cy = -20;
+    ev.pcrev.zoom = XDoubleToFixed(1.5);
+    ev.pcrev.angle = XDoubleToFixed(-0.25);
+    ev.pcrev.distance = 80;
+    CHECK(XGestureEventLogAppendEvent(log, EVENT_BASE, &ev));
+}
+
+static void
+check_records(XGestureEventLog *log)
+{
+    XGestureLogIter iter;
+    XGestureLogRecord rec;
+
+    CHECK_INT(XGestureEventLogCount(log), 4);
+    XGestureEventLogBegin(log, &iter);
+
+    CHECK(XGestureEventLogNext(log, &iter, &rec));
+    CHECK_INT(rec.type, GestureNotifyPan);
+    CHECK_INT(rec.kind, GestureUpdate);
+    CHECK_INT(rec.num_finger, 2);
+    CHECK_INT(rec.aux, 3);
+    CHECK_INT(rec.window, 0x400001);
+    CHECK_INT(rec.time, 1000);
+    CHECK_INT(rec.x, 5);
+    CHECK_INT(rec.y, -6);
+    CHECK_INT(rec.value[0], 42);
+    CHECK_INT(rec.value[1], 7);
+
+    /* the server clock stepped back */
+    CHECK(XGestureEventLogNext(log, &iter, &rec));
+    CHECK_INT(rec.window, 0x400002);
+    CHECK_INT(rec.time, 900);
+
+    CHECK(XGestureEventLogNext(log, &iter, &rec));
+    CHECK_INT(rec.type, GestureNotifyPinchRotation);
+    CHECK_INT(rec.kind, GestureEnd);
+    CHECK_INT(rec.window, 0x400001);
+    CHECK_INT(rec.time, 0xFFFFFFF0);
+    CHECK_INT(rec.x, 320);
+    CHECK_INT(rec.y, -20);
+    CHECK_INT(rec.value[0], XDoubleToFixed(1.5));
+    CHECK_INT(rec.value[1], XDoubleToFixed(-0.25));
+    CHECK_INT(rec.value[2], 80);
+
+    /* and wrapped */
+    CHECK(XGestureEventLogNext(log, &iter, &rec));
+    CHECK_INT(rec.time, 0x20);
+
+    CHECK(!XGestureEventLogNext(log, &iter, &rec));
+}
+
+int
+main(void)
+{
+    XGestureEventLog *log, *copy;
+    char *buf;
+    int size;
+
+    CHECK((log = XGestureEventLogCreate(1)) != NULL);
+    append_pan(log, 0x400001, 1000, 5, -6);
+    append_pan(log, 0x400002, 900, 1, 1);
+    append_pinch(log, 0x400001, 0xFFFFFFF0);
+    append_pan(log, 0x400002, 0x20, 0, 0);
+    check_records(log);
+
+    size = XGestureEventLogSerialize(log, NULL, 0);
+    CHECK(size > 0);
+    CHECK((buf = malloc(size)) != NULL);
+    CHECK_INT(XGestureEventLogSerialize(log, buf, size), size);
+
+    /* truncated or corrupt input is refused */
+    CHECK(XGestureEventLogLoad(buf, size - 1) == NULL);
+    buf[0] ^= 0xff;
+    CHECK(XGestureEventLogLoad(buf, size) == NULL);
+    buf[0] ^= 0xff;
+
+    CHECK((copy = XGestureEventLogLoad(buf, size)) != NULL);
+    check_records(copy);
+
+    XGestureEventLogClear(copy);
+    CHECK_INT(XGestureEventLogCount(copy), 0);
+
+    XGestureEventLogDestroy(copy);
+    XGestureEventLogDestroy(log);
+    free(buf);
+
+    return 0;
+}
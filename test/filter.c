@@ -0,0 +1,163 @@
+/*
+ *
+ * libxgesture
+ *
+ * Contact: Sung-Jin Park <sj76.park@samsung.com>
+ *          Sangjin LEE <lsj119@samsung.com>
+ *
+ * Copyright (c) 2011 Samsung Electronics Co., Ltd All Rights Reserved 
+ *
+ * Permission to use, copy, modify, distribute, and sell this software
+ * and its documentation for any purpose is hereby granted without
+ * fee, provided that the above copyright notice appear in all copies
+ * and that both that copyright notice and this permission notice
+ * appear in supporting documentation, and that the name of Red Hat
+ * not be used in advertising or publicity pertaining to distribution
+ * of the software without specific, written prior permission.  Red
+ * Hat makes no representations about the suitability of this software
+ * for any purpose.  It is provided "as is" without express or implied
+ * warranty.
+ *
+ * THE AUTHORS DISCLAIM ALL WARRANTIES WITH REGARD TO THIS SOFTWARE,
+ * INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS, IN
+ * NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY SPECIAL, INDIRECT OR
+ * CONSEQUENTIAL DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS
+ * OF USE, DATA OR PROFITS, WHETHER IN AN ACTION OF CONTRACT,
+ * NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN
+ * CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ *
+ */
+
+/*
+ * Adaptive smoothing of pan and pinch values.
+ */
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+#include <X11/Xlibint.h>
+#include <X11/extensions/Xext.h>
+#include <X11/extensions/extutil.h>
+#include <X11/extensions/gesture.h>
+#include <X11/extensions/gestureconst.h>
+#include "gestureint.h"
+#include "check.h"
+
+#define NUM_SAMPLES	20
+
+static void
+feed_pan(GestureWindowPtr win, int kind, Time time, int dx, int *out_dx)
+{
+    XEvent event;
+    XGestureCommonEvent *ev = (XGestureCommonEvent *)&event;
+
+    memset(&event, 0, sizeof(event));
+    ev->pev.kind = kind;
+    ev->pev.time = time;
+    ev->pev.dx = dx;
+    _XGestureFilterApply(win, GestureNotifyPan, &event);
+    *out_dx = ev->pev.dx;
+}
+
+static void
+test_pan_total(void)
+{
+    GestureWindowPtr win = Xcalloc(1, sizeof(GestureWindowRec));
+    int i, dx, sum = 0, lagged = 0;
+
+    CHECK(win != NULL);
+    win->filters[GestureNotifyPan] = _XGestureFilterCreate(1.0, 0.007, 1.0);
+    CHECK(win->filters[GestureNotifyPan] != NULL);
+
+    feed_pan(win, GestureBegin, 1000, 10, &dx);
+    sum += dx;
+    for (i = 1; i < NUM_SAMPLES - 1; i++) {
+	feed_pan(win, GestureUpdate, 1000 + i * 10, 10, &dx);
+	sum += dx;
+    }
+    lagged = sum;
+    feed_pan(win, GestureEnd, 1000 + i * 10, 10, &dx);
+    sum += dx;
+
+    /* smoothed while moving, complete once released */
+    CHECK(lagged < (NUM_SAMPLES - 1) * 10);
+    CHECK_INT(sum, NUM_SAMPLES * 10);
+
+    _XGestureFilterFree(win->filters[GestureNotifyPan]);
+    Xfree(win);
+}
+
+static void
+test_clock_wrap(void)
+{
+    GestureWindowPtr win = Xcalloc(1, sizeof(GestureWindowRec));
+    Time start = 0xFFFFFF00;
+    int i, dx;
+
+    win->filters[GestureNotifyPan] = _XGestureFilterCreate(1.0, 0.007, 1.0);
+
+    /* jittery 4/16 px steps; the 32 bit server clock wraps after 11 */
+    feed_pan(win, GestureBegin, start, 16, &dx);
+    for (i = 1; i < NUM_SAMPLES; i++) {
+	feed_pan(win, GestureUpdate, (CARD32)(start + i * 25), i % 2 ? 4 : 16,
+		 &dx);
+	/* a sample passed through unfiltered would jump well past 14 */
+	if (i >= 6)
+	    CHECK(dx >= 6 && dx <= 14);
+    }
+
+    _XGestureFilterFree(win->filters[GestureNotifyPan]);
+    Xfree(win);
+}
+
+static void
+test_pinch_jitter(void)
+{
+    GestureWindowPtr win = Xcalloc(1, sizeof(GestureWindowRec));
+    XEvent event;
+    XGestureCommonEvent *ev = (XGestureCommonEvent *)&event;
+    double zoom, min = 10, max = 0;
+    int i;
+
+    win->filters[GestureNotifyPinchRotation] =
+	_XGestureFilterCreate(1.0, 0.0, 1.0);
+    for (i = 0; i < 50; i++) {
+	memset(&event, 0, sizeof(event));
+	ev->pcrev.kind = i ? GestureUpdate : GestureBegin;
+	ev->pcrev.time = 1000 + i * 10;
+	ev->pcrev.zoom = XDoubleToFixed(i % 2 ? 1.2 : 0.8);
+	_XGestureFilterApply(win, GestureNotifyPinchRotation, &event);
+	zoom = XFixedToDouble(ev->pcrev.zoom);
+	if (i >= 25) {
+	    if (zoom < min)
+		min = zoom;
+	    if (zoom > max)
+		max = zoom;
+	}
+    }
+
+    /* +-0.2 of jitter is mostly removed */
+    CHECK(max - min < 0.1);
+
+    _XGestureFilterFree(win->filters[GestureNotifyPinchRotation]);
+    Xfree(win);
+}
+
+static void
+test_bad_parameters(void)
+{
+    CHECK(_XGestureFilterCreate(0.0, 0.0, 1.0) == NULL);
+    CHECK(_XGestureFilterCreate(1.0, -1.0, 1.0) == NULL);
+    CHECK(_XGestureFilterCreate(1.0, 0.0, 0.0) == NULL);
+}
+
+int
+main(void)
+{
+    test_pan_total();
+    test_clock_wrap();
+    test_pinch_jitter();
+    test_bad_parameters();
+
+    return 0;
+}
@@ -0,0 +1,123 @@
+/*
+ *
+ * libxgesture
+ *
+ * Contact: Sung-Jin Park <sj76.park@samsung.com>
+ *          Sangjin LEE <lsj119@samsung.com>
+ *
+ * Copyright (c) 2011 Samsung Electronics Co., Ltd All Rights Reserved 
+ *
+ * Permission to use, copy, modify, distribute, and sell this software
+ * and its documentation for any purpose is hereby granted without
+ * fee, provided that the above copyright notice appear in all copies
+ * and that both that copyright notice and this permission notice
+ * appear in supporting documentation, and that the name of Red Hat
+ * not be used in advertising or publicity pertaining to distribution
+ * of the software without specific, written prior permission.  Red
+ * Hat makes no representations about the suitability of this software
+ * for any purpose.  It is provided "as is" without express or implied
+ * warranty.
+ *
+ * THE AUTHORS DISCLAIM ALL WARRANTIES WITH REGARD TO THIS SOFTWARE,
+ * INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS, IN
+ * NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY SPECIAL, INDIRECT OR
+ * CONSEQUENTIAL DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS
+ * OF USE, DATA OR PROFITS, WHETHER IN AN ACTION OF CONTRACT,
+ * NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN
+ * CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ *
+ */
+
+/*
+ * Stress benchmark of XGestureGrabEvent/XGestureUngrabEvent with a mix of
+ * valid and invalid arguments.  Invalid calls must fail locally without
+ * queueing a request; the timings show what each kind of call costs.
+ *
+ * Needs a server with the gesture extension on $DISPLAY and is skipped
+ * otherwise.
+ */
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+#include <X11/Xlib.h>
+#include <X11/extensions/gesture.h>
+#include <X11/extensions/gestureconst.h>
+#include <time.h>
+#include "check.h"
+
+#define SKIP		77
+#define ITERATIONS	5000
+
+static double
+now(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+int
+main(void)
+{
+    Display *dpy;
+    Window w;
+    int event_base, error_base;
+    int i, n_valid = 0, n_invalid = 0;
+    double t, t_valid = 0, t_invalid = 0;
+    unsigned long request;
+    Status status;
+
+    if (!(dpy = XOpenDisplay(NULL)))
+	return SKIP;
+    if (!XGestureQueryExtension(dpy, &event_base, &error_base)) {
+	XCloseDisplay(dpy);
+	return SKIP;
+    }
+
+    w = XCreateSimpleWindow(dpy, DefaultRootWindow(dpy), 0, 0, 64, 64, 0, 0, 0);
+    XSync(dpy, False);
+
+    for (i = 0; i < ITERATIONS; i++) {
+	/* four invalid calls, then one valid grab and ungrab */
+	static const struct { int none; int type; int fingers; } bad[] = {
+	    { 1, GestureNotifyTap, 1 },
+	    { 0, -1, 1 },
+	    { 0, GestureNumberEvents, 2 },
+	    { 0, GestureNotifyPan, 0 },
+	    { 0, GestureNotifyPan, 11 },
+	};
+	int k = i % (sizeof(bad) / sizeof(bad[0]));
+	Window target = bad[k].none ? None : w;
+
+	request = XNextRequest(dpy);
+	t = now();
+	status = XGestureGrabEvent(dpy, target, bad[k].type, bad[k].fingers,
+				   CurrentTime);
+	CHECK_INT(status, GestureGrabAbnormal);
+	status = XGestureUngrabEvent(dpy, target, bad[k].type, bad[k].fingers,
+				     CurrentTime);
+	CHECK_INT(status, GestureUngrabAbnormal);
+	t_invalid += now() - t;
+	n_invalid += 2;
+	CHECK_INT(XNextRequest(dpy), request);
+
+	t = now();
+	XGestureGrabEvent(dpy, w, GestureNotifyTap, 1 + i % 3, CurrentTime);
+	XGestureUngrabEvent(dpy, w, GestureNotifyTap, 1 + i % 3, CurrentTime);
+	t_valid += now() - t;
+	n_valid += 2;
+	CHECK(XNextRequest(dpy) != request);
+    }
+
+    printf("invalid: %d calls, %.0f ns/call, no requests sent\n",
+	   n_invalid, t_invalid / n_invalid * 1e9);
+    printf("valid:   %d calls, %.1f us/call (round-trip each)\n",
+	   n_valid, t_valid / n_valid * 1e6);
+
+    XDestroyWindow(dpy, w);
+    XCloseDisplay(dpy);
+
+    return 0;
+}
@@ -0,0 +1,143 @@
+/*
+ *
+ * libxgesture
+ *
+ * Contact: Sung-Jin Park <sj76.park@samsung.com>
+ *          Sangjin LEE <lsj119@samsung.com>
+ *
+ * Copyright (c) 2011 Samsung Electronics Co., Ltd All Rights Reserved 
+ *
+ * Permission to use, copy, modify, distribute, and sell this software
+ * and its documentation for any purpose is hereby granted without
+ * fee, provided that the above copyright notice appear in all copies
+ * and that both that copyright notice and this permission notice
+ * appear in supporting documentation, and that the name of Red Hat
+ * not be used in advertising or publicity pertaining to distribution
+ * of the software without specific, written prior permission.  Red
+ * Hat makes no representations about the suitability of this software
+ * for any purpose.  It is provided "as is" without express or implied
+ * warranty.
+ *
+ * THE AUTHORS DISCLAIM ALL WARRANTIES WITH REGARD TO THIS SOFTWARE,
+ * INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS, IN
+ * NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY SPECIAL, INDIRECT OR
+ * CONSEQUENTIAL DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS
+ * OF USE, DATA OR PROFITS, WHETHER IN AN ACTION OF CONTRACT,
+ * NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN
+ * CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ *
+ */
+
+/*
+ * Range statistics of the per-window gesture history.
+ */
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+#include <X11/Xlibint.h>
+#include <X11/extensions/Xext.h>
+#include <X11/extensions/extutil.h>
+#include <X11/extensions/gesture.h>
+#include <X11/extensions/gestureconst.h>
+#include "gestureint.h"
+#include "check.h"
+
+static void
+add(GestureHistoryPtr h, int type, Time time, int dx, double zoom)
+{
+    XEvent event;
+    XGestureCommonEvent *ev = (XGestureCommonEvent *)&event;
+
+    memset(&event, 0, sizeof(event));
+    ev->any.time = time;
+    if (type == GestureNotifyPan)
+	ev->pev.dx = dx;
+    else if (type == GestureNotifyPinchRotation)
+	ev->pcrev.zoom = XDoubleToFixed(zoom);
+    _XGestureHistoryAdd(h, type, &event);
+}
+
+static void
+test_ranges(void)
+{
+    GestureHistoryPtr h = _XGestureHistoryCreate(16);
+    XGestureHistoryStats st;
+
+    CHECK(h != NULL);
+    add(h, GestureNotifyPan, 100, 5, 0);
+    add(h, GestureNotifyPan, 110, 7, 0);
+    add(h, GestureNotifyTap, 120, 0, 0);
+    add(h, GestureNotifyPinchRotation, 130, 0, 1.5);
+    add(h, GestureNotifyPinchRotation, 140, 0, 2.5);
+    add(h, GestureNotifyPan, 150, -3, 0);
+
+    _XGestureHistoryStats(h, 0, 1000, &st);
+    CHECK_INT(st.num_events, 6);
+    CHECK_INT(st.first_time, 100);
+    CHECK_INT(st.last_time, 150);
+    CHECK_INT(st.num_pan, 3);
+    CHECK_INT(st.sum_dx, 9);
+    CHECK_INT(st.num_tap, 1);
+    CHECK_INT(st.num_pinch, 2);
+    CHECK_INT(st.mean_zoom, XDoubleToFixed(2.0));
+
+    _XGestureHistoryStats(h, 110, 130, &st);
+    CHECK_INT(st.num_events, 3);
+    CHECK_INT(st.num_pan, 1);
+    CHECK_INT(st.sum_dx, 7);
+    CHECK_INT(st.num_pinch, 1);
+
+    _XGestureHistoryStats(h, 151, 200, &st);
+    CHECK_INT(st.num_events, 0);
+
+    _XGestureHistoryFree(h);
+}
+
+static void
+test_eviction(void)
+{
+    GestureHistoryPtr h = _XGestureHistoryCreate(4);
+    XGestureHistoryStats st;
+    int i;
+
+    for (i = 0; i < 10; i++)
+	add(h, GestureNotifyPan, 1000 + i * 10, i, 0);
+
+    _XGestureHistoryStats(h, 0, 5000, &st);
+    CHECK_INT(st.num_events, 4);
+    CHECK_INT(st.first_time, 1060);
+    CHECK_INT(st.sum_dx, 6 + 7 + 8 + 9);
+
+    _XGestureHistoryFree(h);
+}
+
+static void
+test_clock_wrap(void)
+{
+    GestureHistoryPtr h = _XGestureHistoryCreate(8);
+    XGestureHistoryStats st;
+
+    add(h, GestureNotifyTap, 0xFFFFFF00, 0, 0);
+    add(h, GestureNotifyTap, 0xFFFFFF80, 0, 0);
+    add(h, GestureNotifyTap, 0x10, 0, 0);
+    add(h, GestureNotifyTap, 0x50, 0, 0);
+
+    _XGestureHistoryStats(h, 0xFFFFFF00, 0x50, &st);
+    CHECK_INT(st.num_events, 4);
+    _XGestureHistoryStats(h, 0, 0x60, &st);
+    CHECK_INT(st.num_events, 2);
+    CHECK_INT(st.first_time, 0x10);
+
+    _XGestureHistoryFree(h);
+}
+
+int
+main(void)
+{
+    test_ranges();
+    test_eviction();
+    test_clock_wrap();
+
+    return 0;
+}
@@ -0,0 +1,150 @@
+/*
+ *
+ * libxgesture
+ *
+ * Contact: Sung-Jin Park <sj76.park@samsung.com>
+ *          Sangjin LEE <lsj119@samsung.com>
+ *
+ * Copyright (c) 2011 Samsung Electronics Co., Ltd All Rights Reserved 
+ *
+ * Permission to use, copy, modify, distribute, and sell this software
+ * and its documentation for any purpose is hereby granted without
+ * fee, provided that the above copyright notice appear in all copies
+ * and that both that copyright notice and this permission notice
+ * appear in supporting documentation, and that the name of Red Hat
+ * not be used in advertising or publicity pertaining to distribution
+ * of the software without specific, written prior permission.  Red
+ * Hat makes no representations about the suitability of this software
+ * for any purpose.  It is provided "as is" without express or implied
+ * warranty.
+ *
+ * THE AUTHORS DISCLAIM ALL WARRANTIES WITH REGARD TO THIS SOFTWARE,
+ * INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS, IN
+ * NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY SPECIAL, INDIRECT OR
+ * CONSEQUENTIAL DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS
+ * OF USE, DATA OR PROFITS, WHETHER IN AN ACTION OF CONTRACT,
+ * NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN
+ * CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ *
+ */
+
+/*
+ * Kinetic scrolling from Pan and Flick events.
+ */
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+#include <X11/Xlibint.h>
+#include <X11/extensions/gesture.h>
+#include <X11/extensions/gestureconst.h>
+#include "check.h"
+
+#include <math.h>
+
+#define EVENT_BASE	64
+
+static Bool
+pan(XGestureKineticScroller *ks, int kind, Time time, int dx, int dy)
+{
+    XGestureCommonEvent ev;
+
+    memset(&ev, 0, sizeof(ev));
+    ev.pev.type = EVENT_BASE + GestureNotifyPan;
+    ev.pev.kind = kind;
+    ev.pev.time = time;
+    ev.pev.dx = dx;
+    ev.pev.dy = dy;
+
+    return XGestureKineticFeed(ks, EVENT_BASE, &ev);
+}
+
+static void
+test_pan_fling(void)
+{
+    XGestureKineticScroller *ks = XGestureKineticCreate();
+    int i, x, y, prev = 0;
+    Time t;
+
+    CHECK(ks != NULL);
+    CHECK(!pan(ks, GestureBegin, 1000, 0, 0));
+    for (i = 1; i <= 10; i++)
+	CHECK(!pan(ks, GestureUpdate, 1000 + i * 8, 10, 0));
+    CHECK(pan(ks, GestureEnd, 1090, 0, 0));
+
+    /* 1.25 px/ms settles near v0 * tau and never moves backwards */
+    for (t = 1090; XGestureKineticGetOffset(ks, t, &x, &y); t += 16) {
+	CHECK(x >= prev);
+	CHECK_INT(y, 0);
+	prev = x;
+    }
+    CHECK(abs(prev - 406) <= 2);
+
+    /* at rest it keeps reporting the final offset until the next pan */
+    CHECK_INT(x, prev);
+    CHECK(!XGestureKineticGetOffset(ks, t + 5000, &x, &y));
+    CHECK_INT(x, prev);
+    CHECK_INT(y, 0);
+    pan(ks, GestureBegin, t + 6000, 0, 0);
+    CHECK(!XGestureKineticGetOffset(ks, t + 6000, &x, &y));
+    CHECK_INT(x, 0);
+
+    XGestureKineticDestroy(ks);
+}
+
+static void
+test_rested_release(void)
+{
+    XGestureKineticScroller *ks = XGestureKineticCreate();
+    int i, x, y;
+
+    pan(ks, GestureBegin, 1000, 0, 0);
+    for (i = 1; i <= 10; i++)
+	pan(ks, GestureUpdate, 1000 + i * 8, 10, 0);
+    pan(ks, GestureUpdate, 1600, 0, 0);
+
+    /* the finger rested before lifting: nothing to fling */
+    CHECK(!pan(ks, GestureEnd, 2580, 0, 0));
+    CHECK(!XGestureKineticGetOffset(ks, 3080, &x, &y));
+    CHECK_INT(x, 0);
+
+    XGestureKineticDestroy(ks);
+}
+
+static void
+test_flick(void)
+{
+    XGestureKineticScroller *ks = XGestureKineticCreate();
+    XGestureCommonEvent ev;
+    int x, y;
+
+    memset(&ev, 0, sizeof(ev));
+    ev.fev.type = EVENT_BASE + GestureNotifyFlick;
+    ev.fev.kind = GestureEnd;
+    ev.fev.time = 5000;
+    ev.fev.distance = 200;
+    ev.fev.duration = 100;
+    ev.fev.angle = XDoubleToFixed(M_PI / 2);	/* straight up */
+    CHECK(XGestureKineticFeed(ks, EVENT_BASE, &ev));
+
+    CHECK(XGestureKineticGetOffset(ks, 5325, &x, &y));
+    CHECK(abs(x) <= 1);
+    CHECK(abs(y + 411) <= 3);	/* 2 * 325 * (1 - 1/e) */
+
+    XGestureKineticStop(ks);
+    CHECK(!XGestureKineticGetOffset(ks, 5400, &x, &y));
+    CHECK_INT(x, 0);
+    CHECK_INT(y, 0);
+
+    XGestureKineticDestroy(ks);
+}
+
+int
+main(void)
+{
+    test_pan_fling();
+    test_rested_release();
+    test_flick();
+
+    return 0;
+}
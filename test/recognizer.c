@@ -0,0 +1,304 @@
+/*
+ *
+ * libxgesture
+ *
+ * Contact: Sung-Jin Park <sj76.park@samsung.com>
+ *          Sangjin LEE <lsj119@samsung.com>
+ *
+ * Copyright (c) 2011 Samsung Electronics Co., Ltd All Rights Reserved 
+ *
+ * Permission to use, copy, modify, distribute, and sell this software
+ * and its documentation for any purpose is hereby granted without
+ * fee, provided that the above copyright notice appear in all copies
+ * and that both that copyright notice and this permission notice
+ * appear in supporting documentation, and that the name of Red Hat
+ * not be used in advertising or publicity pertaining to distribution
+ * of the software without specific, written prior permission.  Red
+ * Hat makes no representations about the suitability of this software
+ * for any purpose.  It is provided "as is" without express or implied
+ * warranty.
+ *
+ * THE AUTHORS DISCLAIM ALL WARRANTIES WITH REGARD TO THIS SOFTWARE,
+ * INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS, IN
+ * NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY SPECIAL, INDIRECT OR
+ * CONSEQUENTIAL DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS
+ * OF USE, DATA OR PROFITS, WHETHER IN AN ACTION OF CONTRACT,
+ * NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN
+ * CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ *
+ */
+
+/*
+ * Replays recorded touch traces through the client side recognizer and
+ * checks the synthesized gesture events.  No X server is involved.
+ */
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+#include <X11/Xlibint.h>
+#include <X11/extensions/gesture.h>
+#include <X11/extensions/gestureconst.h>
+#include <math.h>
+#include "check.h"
+
+#define EVENT_BASE	64
+#define WINDOW		0x200001
+#define MAX_EVENTS	64
+
+/* pseudo sample type: run XGestureRecognizerTimeout() at the given time */
+#define TIMEOUT		-1
+
+#define B(id, t, x, y)	{ XGestureTouchBegin, id, WINDOW, t, x, y }
+#define U(id, t, x, y)	{ XGestureTouchUpdate, id, WINDOW, t, x, y }
+#define E(id, t, x, y)	{ XGestureTouchEnd, id, WINDOW, t, x, y }
+#define T(t)		{ TIMEOUT, 0, 0, t, 0, 0 }
+
+static XGestureCommonEvent events[MAX_EVENTS];
+static int num_events;
+
+static void
+replay(const XGestureTouchSample *trace, int len)
+{
+    XGestureRecognizer *rec = XGestureRecognizerCreate(NULL, EVENT_BASE);
+    int i;
+
+    CHECK(rec != NULL);
+    num_events = 0;
+    for (i = 0; i < len; i++) {
+	if (trace[i].type == TIMEOUT)
+	    num_events += XGestureRecognizerTimeout(rec, trace[i].time,
+						    events + num_events,
+						    MAX_EVENTS - num_events);
+	else
+	    num_events += XGestureRecognizerFeed(rec, &trace[i],
+						 events + num_events,
+						 MAX_EVENTS - num_events);
+    }
+    XGestureRecognizerDestroy(rec);
+}
+
+#define REPLAY(trace)	replay(trace, sizeof(trace) / sizeof(trace[0]))
+
+static void
+check_event(int i, int type, int kind)
+{
+    CHECK(i < num_events);
+    CHECK_INT(events[i].any.type, EVENT_BASE + type);
+    CHECK_INT(events[i].any.kind, kind);
+    CHECK_INT(events[i].any.window, WINDOW);
+}
+
+static void
+test_tap(void)
+{
+    static const XGestureTouchSample trace[] = {
+	B(1, 1000, 100, 100),
+	U(1, 1040, 104, 102),
+	E(1, 1100, 104, 102),
+    };
+
+    REPLAY(trace);
+    CHECK_INT(num_events, 1);
+    check_event(0, GestureNotifyTap, GestureEnd);
+    CHECK_INT(events[0].tev.num_finger, 1);
+    CHECK_INT(events[0].tev.cx, 100);
+    CHECK_INT(events[0].tev.cy, 100);
+    CHECK_INT(events[0].tev.tap_repeat, 1);
+}
+
+static void
+test_double_tap(void)
+{
+    static const XGestureTouchSample trace[] = {
+	B(1, 1000, 100, 100),
+	E(1, 1080, 100, 100),
+	B(2, 1250, 108, 95),
+	E(2, 1320, 108, 95),
+	/* too late to repeat */
+	B(3, 2000, 100, 100),
+	E(3, 2060, 100, 100),
+    };
+
+    REPLAY(trace);
+    CHECK_INT(num_events, 3);
+    check_event(0, GestureNotifyTap, GestureEnd);
+    CHECK_INT(events[0].tev.tap_repeat, 1);
+    check_event(1, GestureNotifyTap, GestureEnd);
+    CHECK_INT(events[1].tev.tap_repeat, 2);
+    CHECK_INT(events[1].tev.interval, 240);
+    check_event(2, GestureNotifyTap, GestureEnd);
+    CHECK_INT(events[2].tev.tap_repeat, 1);
+}
+
+static void
+test_pan_flick(void)
+{
+    static const XGestureTouchSample trace[] = {
+	B(1, 1000, 100, 300),
+	U(1, 1020, 130, 300),
+	U(1, 1040, 170, 300),
+	U(1, 1060, 220, 300),
+	E(1, 1070, 250, 300),
+    };
+    int i, sum = 0;
+
+    REPLAY(trace);
+    CHECK_INT(num_events, 6);
+    check_event(0, GestureNotifyPan, GestureBegin);
+    check_event(1, GestureNotifyPan, GestureUpdate);
+    check_event(2, GestureNotifyPan, GestureUpdate);
+    check_event(3, GestureNotifyPan, GestureUpdate);
+    check_event(4, GestureNotifyPan, GestureEnd);
+    for (i = 0; i < 5; i++) {
+	CHECK_INT(events[i].pev.dy, 0);
+	sum += events[i].pev.dx;
+    }
+    CHECK_INT(sum, 150);
+    CHECK_INT(events[4].pev.distance, 150);
+
+    check_event(5, GestureNotifyFlick, GestureEnd);
+    CHECK_INT(events[5].fev.direction, 0);
+    CHECK_INT(events[5].fev.distance, 150);
+    CHECK_INT(events[5].fev.duration, 70);
+    CHECK(fabs(XFixedToDouble(events[5].fev.angle)) < 0.01);
+}
+
+static void
+test_slow_pan_no_flick(void)
+{
+    static const XGestureTouchSample trace[] = {
+	B(1, 1000, 100, 100),
+	U(1, 1200, 100, 150),
+	U(1, 1400, 100, 200),
+	E(1, 1600, 100, 250),
+    };
+
+    REPLAY(trace);
+    CHECK_INT(num_events, 4);
+    check_event(0, GestureNotifyPan, GestureBegin);
+    check_event(3, GestureNotifyPan, GestureEnd);
+}
+
+static void
+test_pan_finger_change(void)
+{
+    /* a second finger landing far away must not jump the pan */
+    static const XGestureTouchSample trace[] = {
+	B(1, 1000, 100, 100),
+	U(1, 1100, 130, 100),
+	U(1, 1200, 140, 100),
+	B(2, 1210, 440, 100),
+	U(1, 1300, 150, 100),
+	U(2, 1300, 450, 100),
+	E(2, 1400, 450, 100),
+	U(1, 1500, 160, 100),
+	E(1, 1600, 160, 100),
+    };
+    int i, sum = 0;
+
+    REPLAY(trace);
+    CHECK(num_events >= 2);
+    for (i = 0; i < num_events; i++) {
+	check_event(i, GestureNotifyPan,
+		    i == 0 ? GestureBegin :
+		    i == num_events - 1 ? GestureEnd : GestureUpdate);
+	CHECK(abs(events[i].pev.dx) <= 30);
+	sum += events[i].pev.dx;
+    }
+    CHECK_INT(sum, 60);
+}
+
+static void
+test_pinch(void)
+{
+    static const XGestureTouchSample trace[] = {
+	B(1, 1000, 100, 200),
+	B(2, 1010, 200, 200),
+	U(2, 1050, 230, 200),
+	U(2, 1100, 300, 200),
+	E(1, 1200, 100, 200),
+	E(2, 1210, 300, 200),
+    };
+
+    REPLAY(trace);
+    CHECK_INT(num_events, 3);
+    check_event(0, GestureNotifyPinchRotation, GestureBegin);
+    CHECK_INT(events[0].pcrev.num_finger, 2);
+    CHECK(fabs(XFixedToDouble(events[0].pcrev.zoom) - 1.3) < 0.01);
+    check_event(1, GestureNotifyPinchRotation, GestureUpdate);
+    CHECK(fabs(XFixedToDouble(events[1].pcrev.zoom) - 2.0) < 0.01);
+    CHECK(fabs(XFixedToDouble(events[1].pcrev.angle)) < 0.01);
+    check_event(2, GestureNotifyPinchRotation, GestureEnd);
+}
+
+static void
+test_pinch_angle_wrap(void)
+{
+    /* second finger left of the first: jitter crosses the atan2 branch cut */
+    static const XGestureTouchSample trace[] = {
+	B(1, 1000, 300, 100),
+	B(2, 1010, 100, 100),
+	U(2, 1100, 100, 101),
+	U(2, 1200, 100, 99),
+	E(1, 1300, 300, 100),
+	E(2, 1300, 100, 99),
+    };
+
+    REPLAY(trace);
+    CHECK_INT(num_events, 0);
+}
+
+static void
+test_hold(void)
+{
+    static const XGestureTouchSample trace[] = {
+	B(1, 1000, 100, 100),
+	U(1, 1200, 105, 100),
+	T(1600),
+	E(1, 1800, 105, 100),
+    };
+
+    REPLAY(trace);
+    CHECK_INT(num_events, 2);
+    check_event(0, GestureNotifyHold, GestureBegin);
+    CHECK_INT(events[0].hev.holdtime, 600);
+    check_event(1, GestureNotifyHold, GestureEnd);
+    CHECK_INT(events[1].hev.holdtime, 800);
+}
+
+static void
+test_tap_n_hold(void)
+{
+    static const XGestureTouchSample trace[] = {
+	B(1, 1000, 100, 100),
+	E(1, 1080, 100, 100),
+	B(2, 1200, 100, 100),
+	T(1750),
+	E(2, 1900, 100, 100),
+    };
+
+    REPLAY(trace);
+    CHECK_INT(num_events, 3);
+    check_event(0, GestureNotifyTap, GestureEnd);
+    check_event(1, GestureNotifyTapNHold, GestureBegin);
+    CHECK_INT(events[1].thev.interval, 120);
+    check_event(2, GestureNotifyTapNHold, GestureEnd);
+    CHECK_INT(events[2].thev.holdtime, 700);
+}
+
+int
+main(void)
+{
+    test_tap();
+    test_double_tap();
+    test_pan_flick();
+    test_slow_pan_no_flick();
+    test_pan_finger_change();
+    test_pinch();
+    test_pinch_angle_wrap();
+    test_hold();
+    test_tap_n_hold();
+
+    return 0;
+}
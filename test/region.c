@@ -0,0 +1,160 @@
+/*
+ *
+ * libxgesture
+ *
+ * Contact: Sung-Jin Park <sj76.park@samsung.com>
+ *          Sangjin LEE <lsj119@samsung.com>
+ *
+ * Copyright (c) 2011 Samsung Electronics Co., Ltd All Rights Reserved 
+ *
+ * Permission to use, copy, modify, distribute, and sell this software
+ * and its documentation for any purpose is hereby granted without
+ * fee, provided that the above copyright notice appear in all copies
+ * and that both that copyright notice and this permission notice
+ * appear in supporting documentation, and that the name of Red Hat
+ * not be used in advertising or publicity pertaining to distribution
+ * of the software without specific, written prior permission.  Red
+ * Hat makes no representations about the suitability of this software
+ * for any purpose.  It is provided "as is" without express or implied
+ * warranty.
+ *
+ * THE AUTHORS DISCLAIM ALL WARRANTIES WITH REGARD TO THIS SOFTWARE,
+ * INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS, IN
+ * NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY SPECIAL, INDIRECT OR
+ * CONSEQUENTIAL DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS
+ * OF USE, DATA OR PROFITS, WHETHER IN AN ACTION OF CONTRACT,
+ * NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN
+ * CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ *
+ */
+
+/*
+ * Region hit-testing, coordinate clamping and Pan/Flick inheritance.
+ */
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+#include <X11/Xlibint.h>
+#include <X11/extensions/Xext.h>
+#include <X11/extensions/extutil.h>
+#include <X11/extensions/gesture.h>
+#include <X11/extensions/gestureconst.h>
+#include "gestureint.h"
+#include "check.h"
+
+#include <limits.h>
+
+static unsigned long
+resolve(GestureWindowPtr win, int type, int kind, int x, int y)
+{
+    XEvent event;
+    XGestureCommonEvent *ev = (XGestureCommonEvent *)&event;
+
+    memset(&event, 0, sizeof(event));
+    ev->any.kind = kind;
+    switch (type) {
+    case GestureNotifyTap:
+	ev->tev.has_local = True;
+	ev->tev.local_x = x;
+	ev->tev.local_y = y;
+	_XGestureRegionsResolve(win, type, &event);
+	return ev->tev.target;
+    case GestureNotifyHold:
+	ev->hev.has_local = True;
+	ev->hev.local_x = x;
+	ev->hev.local_y = y;
+	_XGestureRegionsResolve(win, type, &event);
+	return ev->hev.target;
+    case GestureNotifyPan:
+	_XGestureRegionsResolve(win, type, &event);
+	return ev->pev.target;
+    }
+
+    return 0;
+}
+
+#define tap(win, x, y)	resolve(win, GestureNotifyTap, GestureDone, x, y)
+
+static void
+test_stacking(void)
+{
+    GestureWindowRec win;
+
+    memset(&win, 0, sizeof(win));
+    CHECK(_XGestureRegionsAdd(&win.regions, 1, 0, 0, 100, 100));
+    CHECK(_XGestureRegionsAdd(&win.regions, 2, 50, 50, 100, 100));
+    CHECK(_XGestureRegionsAdd(&win.regions, 3, 1000, 1000, 10, 10));
+
+    CHECK_INT(tap(&win, 10, 10), 1);
+    CHECK_INT(tap(&win, 60, 60), 2);	/* newest on top */
+    CHECK_INT(tap(&win, 149, 149), 2);
+    CHECK_INT(tap(&win, 150, 150), 0);	/* right/bottom edges exclusive */
+    CHECK_INT(tap(&win, 1005, 1005), 3);
+    CHECK_INT(tap(&win, -1, 0), 0);
+
+    /* re-registering moves the region but keeps it below 2 */
+    CHECK(_XGestureRegionsAdd(&win.regions, 1, 40, 40, 100, 100));
+    CHECK_INT(tap(&win, 60, 60), 2);
+    CHECK_INT(tap(&win, 45, 45), 1);
+    CHECK_INT(tap(&win, 10, 10), 0);
+
+    /* ids are non-zero and empty regions are refused */
+    CHECK(!_XGestureRegionsAdd(&win.regions, 0, 0, 0, 10, 10));
+    CHECK(!_XGestureRegionsAdd(&win.regions, 4, 0, 0, 0, 10));
+
+    _XGestureRegionsFree(win.regions);
+}
+
+static void
+test_clamp(void)
+{
+    GestureWindowRec win;
+
+    memset(&win, 0, sizeof(win));
+
+    /* these used to overflow the grid extent */
+    CHECK(_XGestureRegionsAdd(&win.regions, 1, INT_MIN, INT_MIN,
+			      UINT_MAX, UINT_MAX));
+    CHECK(_XGestureRegionsAdd(&win.regions, 2, 32000, 32000,
+			      UINT_MAX, UINT_MAX));
+
+    CHECK_INT(tap(&win, -32768, -32768), 1);
+    CHECK_INT(tap(&win, 0, 0), 1);
+    CHECK_INT(tap(&win, 32766, 32766), 2);
+    CHECK_INT(tap(&win, 32767, 32767), 0);
+
+    /* nothing is left of a region entirely outside the range */
+    CHECK(!_XGestureRegionsAdd(&win.regions, 3, 40000, 0, 10, 10));
+    CHECK(!_XGestureRegionsAdd(&win.regions, 3, INT_MAX - 10, 0, 100, 100));
+
+    _XGestureRegionsFree(win.regions);
+}
+
+static void
+test_inherit(void)
+{
+    GestureWindowRec win;
+
+    memset(&win, 0, sizeof(win));
+    CHECK(_XGestureRegionsAdd(&win.regions, 7, 0, 0, 100, 100));
+
+    /* Pan has no position: it only follows the gesture in progress */
+    CHECK_INT(resolve(&win, GestureNotifyPan, GestureBegin, 0, 0), 0);
+    CHECK_INT(resolve(&win, GestureNotifyHold, GestureBegin, 10, 10), 7);
+    CHECK_INT(resolve(&win, GestureNotifyPan, GestureUpdate, 0, 0), 7);
+    CHECK_INT(resolve(&win, GestureNotifyHold, GestureEnd, 10, 10), 7);
+    CHECK_INT(resolve(&win, GestureNotifyPan, GestureUpdate, 0, 0), 0);
+
+    _XGestureRegionsFree(win.regions);
+}
+
+int
+main(void)
+{
+    test_stacking();
+    test_clamp();
+    test_inherit();
+
+    return 0;
+}
@@ -0,0 +1,178 @@
+/*
+ *
+ * libxgesture
+ *
+ * Contact: Sung-Jin Park <sj76.park@samsung.com>
+ *          Sangjin LEE <lsj119@samsung.com>
+ *
+ * Copyright (c) 2011 Samsung Electronics Co., Ltd All Rights Reserved 
+ *
+ * Permission to use, copy, modify, distribute, and sell this software
+ * and its documentation for any purpose is hereby granted without
+ * fee, provided that the above copyright notice appear in all copies
+ * and that both that copyright notice and this permission notice
+ * appear in supporting documentation, and that the name of Red Hat
+ * not be used in advertising or publicity pertaining to distribution
+ * of the software without specific, written prior permission.  Red
+ * Hat makes no representations about the suitability of this software
+ * for any purpose.  It is provided "as is" without express or implied
+ * warranty.
+ *
+ * THE AUTHORS DISCLAIM ALL WARRANTIES WITH REGARD TO THIS SOFTWARE,
+ * INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS, IN
+ * NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY SPECIAL, INDIRECT OR
+ * CONSEQUENTIAL DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS
+ * OF USE, DATA OR PROFITS, WHETHER IN AN ACTION OF CONTRACT,
+ * NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN
+ * CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ *
+ */
+
+/*
+ * Scaling benchmark of the gesture entry points under concurrency.  N
+ * threads call XGestureQueryVersion, XGestureSelectEvents and
+ * XGestureGrabEvent/XGestureUngrabEvent in a loop, first sharing one
+ * Display and then each on its own, and the aggregate rate is printed
+ * per thread count.
+ *
+ * Needs a server with the gesture extension on $DISPLAY and is skipped
+ * otherwise.
+ */
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+#include <X11/Xlib.h>
+#include <X11/extensions/gesture.h>
+#include <X11/extensions/gestureconst.h>
+#include <pthread.h>
+#include <time.h>
+#include "check.h"
+
+#define SKIP		77
+#define MAX_THREADS	8
+#define ITERATIONS	2000
+
+typedef struct {
+    Display *dpy;
+    Window w;
+    int op;
+} Worker;
+
+enum { OP_QUERY_VERSION, OP_SELECT, OP_GRAB, NUM_OPS };
+
+static const char *op_names[NUM_OPS] = {
+    "QueryVersion", "SelectEvents", "Grab/Ungrab"
+};
+
+static double
+now(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+static void *
+run(void *data)
+{
+    Worker *wk = data;
+    int major, minor, patch;
+    int i;
+
+    for (i = 0; i < ITERATIONS; i++) {
+	switch (wk->op) {
+	case OP_QUERY_VERSION:
+	    XGestureQueryVersion(wk->dpy, &major, &minor, &patch);
+	    break;
+	case OP_SELECT:
+	    XGestureSelectEvents(wk->dpy, wk->w,
+				 1L << ((i & 1) ? GestureNotifyTap
+						 : GestureNotifyPan));
+	    break;
+	case OP_GRAB:
+	    XGestureGrabEvent(wk->dpy, wk->w, GestureNotifyTap, 1, CurrentTime);
+	    XGestureUngrabEvent(wk->dpy, wk->w, GestureNotifyTap, 1, CurrentTime);
+	    break;
+	}
+    }
+    XSync(wk->dpy, False);
+
+    return NULL;
+}
+
+static Window
+create_window(Display *dpy)
+{
+    Window w = XCreateSimpleWindow(dpy, DefaultRootWindow(dpy),
+				   0, 0, 64, 64, 0, 0, 0);
+
+    XSync(dpy, False);
+    return w;
+}
+
+/* aggregate calls per second of op over nthreads threads */
+static double
+measure(Display *shared, Display **own, int op, int nthreads)
+{
+    pthread_t threads[MAX_THREADS];
+    Worker workers[MAX_THREADS];
+    double t;
+    int i;
+
+    for (i = 0; i < nthreads; i++) {
+	workers[i].dpy = shared ? shared : own[i];
+	workers[i].w = create_window(workers[i].dpy);
+	workers[i].op = op;
+    }
+
+    t = now();
+    for (i = 0; i < nthreads; i++)
+	CHECK(pthread_create(&threads[i], NULL, run, &workers[i]) == 0);
+    for (i = 0; i < nthreads; i++)
+	pthread_join(threads[i], NULL);
+    t = now() - t;
+
+    for (i = 0; i < nthreads; i++)
+	XDestroyWindow(workers[i].dpy, workers[i].w);
+
+    return nthreads * ITERATIONS / t;
+}
+
+int
+main(void)
+{
+    Display *shared;
+    Display *own[MAX_THREADS];
+    int event_base, error_base;
+    int major, minor, patch;
+    int op, n, i;
+
+    XInitThreads();
+    if (!(shared = XOpenDisplay(NULL)))
+	return SKIP;
+    if (!XGestureQueryExtension(shared, &event_base, &error_base) ||
+	!XGestureQueryVersion(shared, &major, &minor, &patch)) {
+	XCloseDisplay(shared);
+	return SKIP;
+    }
+    for (i = 0; i < MAX_THREADS; i++) {
+	own[i] = XOpenDisplay(NULL);
+	CHECK(own[i] != NULL);
+	CHECK(XGestureQueryVersion(own[i], &major, &minor, &patch));
+    }
+
+    for (op = 0; op < NUM_OPS; op++) {
+	for (n = 1; n <= MAX_THREADS; n *= 2)
+	    printf("%-12s %d threads: shared display %9.0f calls/s, "
+		   "display per thread %9.0f calls/s\n", op_names[op], n,
+		   measure(shared, NULL, op, n), measure(NULL, own, op, n));
+    }
+
+    for (i = 0; i < MAX_THREADS; i++)
+	XCloseDisplay(own[i]);
+    XCloseDisplay(shared);
+
+    return 0;
+}
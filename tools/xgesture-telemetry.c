@@ -0,0 +1,131 @@
+/*
+ *
+ * libxgesture
+ *
+ * Contact: Sung-Jin Park <sj76.park@samsung.com>
+ *          Sangjin LEE <lsj119@samsung.com>
+ *
+ * Copyright (c) 2011 Samsung Electronics Co., Ltd All Rights Reserved 
+ *
+ * Permission to use, copy, modify, distribute, and sell this software
+ * and its documentation for any purpose is hereby granted without
+ * fee, provided that the above copyright notice appear in all copies
+ * and that both that copyright notice and this permission notice
+ * appear in supporting documentation, and that the name of Red Hat
+ * not be used in advertising or publicity pertaining to distribution
+ * of the software without specific, written prior permission.  Red
+ * Hat makes no representations about the suitability of this software
+ * for any purpose.  It is provided "as is" without express or implied
+ * warranty.
+ *
+ * THE AUTHORS DISCLAIM ALL WARRANTIES WITH REGARD TO THIS SOFTWARE,
+ * INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS, IN
+ * NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY SPECIAL, INDIRECT OR
+ * CONSEQUENTIAL DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS
+ * OF USE, DATA OR PROFITS, WHETHER IN AN ACTION OF CONTRACT,
+ * NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN
+ * CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ *
+ */
+
+/*
+ * xgesture-telemetry: dump a gesture telemetry file written by
+ * XGestureStartTelemetry(), oldest record first.
+ */
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+#include <X11/extensions/gestureconst.h>
+#include "telemetry.h"
+
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+static const char *type_names[] = {
+    [GestureNotifyGroup] = "group",
+    [GestureNotifyFlick] = "flick",
+    [GestureNotifyPan] = "pan",
+    [GestureNotifyPinchRotation] = "pinchrotation",
+    [GestureNotifyTap] = "tap",
+    [GestureNotifyTapNHold] = "tapnhold",
+    [GestureNotifyHold] = "hold",
+};
+
+static void
+usage(const char *prog)
+{
+    fprintf(stderr, "usage: %s FILE\n", prog);
+    exit(1);
+}
+
+int
+main(int argc, char **argv)
+{
+    const GestureTelemetryHeader *h;
+    GestureTelemetryRecord rec;
+    const unsigned char *slots;
+    struct stat st;
+    uint64_t written, first, n;
+    void *map;
+    int fd;
+
+    if (argc != 2)
+	usage(argv[0]);
+
+    if ((fd = open(argv[1], O_RDONLY)) < 0 || fstat(fd, &st) < 0) {
+	perror(argv[1]);
+	return 1;
+    }
+    if ((size_t)st.st_size < sizeof(GestureTelemetryHeader)) {
+	fprintf(stderr, "%s: file too short\n", argv[1]);
+	return 1;
+    }
+    map = mmap(NULL, st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (map == MAP_FAILED) {
+	perror(argv[1]);
+	return 1;
+    }
+
+    h = map;
+    if (h->magic != GESTURE_TELEMETRY_MAGIC ||
+	h->version != GESTURE_TELEMETRY_VERSION ||
+	h->slot_size < sizeof(uint16_t) || !h->num_slots ||
+	h->header_size + (uint64_t)h->slot_size * h->num_slots > (uint64_t)st.st_size) {
+	fprintf(stderr, "%s: not a gesture telemetry file\n", argv[1]);
+	return 1;
+    }
+    slots = (const unsigned char *)map + h->header_size;
+
+    written = __atomic_load_n(&h->records_written, __ATOMIC_ACQUIRE);
+    first = written > h->num_slots ? written - h->num_slots : 0;
+
+    printf("# %llu records, %llu overwritten\n",
+	   (unsigned long long)written, (unsigned long long)first);
+    printf("# time type kind fingers direction duration distance window\n");
+
+    for (n = first; n < written; n++) {
+	memset(&rec, 0, sizeof(rec));
+	memcpy(&rec, slots + (n % h->num_slots) * h->slot_size,
+	       h->slot_size < sizeof(rec) ? h->slot_size : sizeof(rec));
+	if (rec.length < sizeof(rec)) {
+	    /* fields beyond the recorded length are unknown, skip the record */
+	    continue;
+	}
+
+	printf("%u %s %u %u %u %u %d 0x%x\n", rec.time,
+	       rec.type < sizeof(type_names) / sizeof(type_names[0]) &&
+	       type_names[rec.type] ? type_names[rec.type] : "unknown",
+	       rec.kind, rec.num_finger, rec.direction, rec.duration,
+	       rec.distance, rec.window);
+    }
+
+    munmap(map, st.st_size);
+    return 0;
+}